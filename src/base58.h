@@ -124,6 +124,7 @@ public:
 
     CTxDestination Get() const;
     bool GetKeyID(CKeyID& keyID) const;
+    bool GetKeyID(CKeyID& keyID, const CChainParams& params) const;
     bool IsScript() const;
 };
 
@@ -12,6 +12,7 @@
 #include "uint256.h"
 #include "wallet/wallet.h"
 #include <boost/filesystem.hpp>
+#include <boost/unordered_map.hpp>
 #include <boost/signals2/signal.hpp>
 #include <boost/exception/to_string.hpp>
 
@@ -79,14 +80,58 @@ bool ExtractPayouts(const CBlock& block, const int& nBlockHeight, std::vector<CT
     return fStakesFound || (nWinnerPayments == 0 && totalStakeAcc + nMNReward < stakeAmount);
 }
 
-bool IsBlockPayoutsValid(CBettingsView &bettingsViewCache, const std::multimap<CPayoutInfoDB, CBetOut>& mExpectedPayoutsIn, const CBlock& block, const int nBlockHeight, const CAmount& nExpectedMint, const CAmount& nExpectedMNReward)
+namespace {
+
+struct PayoutHasher {
+    size_t operator()(const CTxOut& txOut) const
+    {
+        return MurmurHash3(static_cast<unsigned int>(txOut.nValue), txOut.scriptPubKey);
+    }
+};
+
+struct PayoutEqual {
+    bool operator()(const CTxOut& a, const CTxOut& b) const
+    {
+        return a.nValue == b.nValue && a.scriptPubKey == b.scriptPubKey;
+    }
+};
+
+} // anonymous namespace
+
+bool MatchExpectedPayouts(const std::multimap<CPayoutInfoDB, CBetOut>& mExpectedPayouts, const std::vector<CTxOut>& vFoundPayouts, std::vector<const CPayoutInfoDB*>& vPayoutsInfo)
+{
+    typedef std::multimap<CPayoutInfoDB, CBetOut>::const_iterator ExpectedPayoutIt;
+    // Expected payouts sharing value and script are kept in map order, so every found
+    // payout is assigned the first unused payout info in that order.
+    boost::unordered_map<CTxOut, std::pair<std::vector<ExpectedPayoutIt>, size_t>, PayoutHasher, PayoutEqual> mapExpectedPayouts;
+
+    if (mExpectedPayouts.size() != vFoundPayouts.size()) return false;
+
+    mapExpectedPayouts.reserve(mExpectedPayouts.size());
+    for (auto it = mExpectedPayouts.begin(); it != mExpectedPayouts.end(); ++it) {
+        mapExpectedPayouts[it->second].first.push_back(it);
+    }
+
+    vPayoutsInfo.clear();
+    vPayoutsInfo.reserve(vFoundPayouts.size());
+    for (const CTxOut& foundPayout : vFoundPayouts) {
+        auto it = mapExpectedPayouts.find(foundPayout);
+        if (it == mapExpectedPayouts.end()) return false;
+        std::vector<ExpectedPayoutIt>& vCandidates = it->second.first;
+        size_t& nUsed = it->second.second;
+        if (nUsed == vCandidates.size()) return false;
+        vPayoutsInfo.push_back(&vCandidates[nUsed++]->first);
+    }
+
+    return true;
+}
+
+bool IsBlockPayoutsValid(CBettingsView &bettingsViewCache, const std::multimap<CPayoutInfoDB, CBetOut>& mExpectedPayouts, const CBlock& block, const int nBlockHeight, const CAmount& nExpectedMint, const CAmount& nExpectedMNReward)
 {
     const CTransaction &tx = block.vtx[1];
-    std::multimap<CPayoutInfoDB, CBetOut> mExpectedPayouts = mExpectedPayoutsIn;
 
     std::vector<CTxOut> vFoundPayouts;
-    std::multiset<CTxOut> setFoundPayouts;
-    std::multiset<CTxOut> setExpectedPayouts;
+    std::vector<const CPayoutInfoDB*> vPayoutsInfo;
 
     uint32_t nPayoutOffset = 0;
     uint32_t nWinnerPayments = 0; // unused
@@ -96,14 +141,13 @@ bool IsBlockPayoutsValid(CBettingsView &bettingsViewCache, const std::multimap<C
         LogPrintf("%s - Not all payouts found - %s\n", __func__, block.GetHash().ToString());
         return false;
     }
-    setFoundPayouts = std::multiset<CTxOut>(vFoundPayouts.begin(), vFoundPayouts.end());
 
-    for (auto expectedPayout : mExpectedPayouts)
-    {
-        setExpectedPayouts.insert(expectedPayout.second);
-    }
-
-    if (setExpectedPayouts != setFoundPayouts) {
+    if (!MatchExpectedPayouts(mExpectedPayouts, vFoundPayouts, vPayoutsInfo)) {
+        std::multiset<CTxOut> setFoundPayouts(vFoundPayouts.begin(), vFoundPayouts.end());
+        std::multiset<CTxOut> setExpectedPayouts;
+        for (const auto& expectedPayout : mExpectedPayouts) {
+            setExpectedPayouts.insert(expectedPayout.second);
+        }
         LogPrintf("%s - Expected payouts:\n", __func__);
         for (auto expectedPayout : setExpectedPayouts) {
             LogPrintf("%s %d %d\n", expectedPayout.nRounds, expectedPayout.nValue, expectedPayout.scriptPubKey.ToString());
@@ -116,24 +160,14 @@ bool IsBlockPayoutsValid(CBettingsView &bettingsViewCache, const std::multimap<C
         return false;
     }
 
-    // Lookup txid+voutnr and store in database cache
-    for (uint32_t i = 0; i < vFoundPayouts.size(); i++)
-    {
-        auto expectedPayout = std::find_if(mExpectedPayouts.begin(), mExpectedPayouts.end(),
-                        [vFoundPayouts, i](std::pair<const CPayoutInfoDB, CBetOut> eP) {
-                            return eP.second.nValue == vFoundPayouts[i].nValue && eP.second.scriptPubKey == vFoundPayouts[i].scriptPubKey;
-                        });
-        if (expectedPayout != mExpectedPayouts.end()) {
-            PayoutInfoKey payoutInfoKey{static_cast<uint32_t>(nBlockHeight), COutPoint{tx.GetHash(), i+nPayoutOffset}};
-            bettingsViewCache.payoutsInfo->Write(payoutInfoKey, expectedPayout->first);
-
-            mExpectedPayouts.erase(expectedPayout);
-        } else {
-            // Redundant: should not happen after previous test 'setExpectedPayouts != setFoundPayouts'
-            LogPrintf("%s - Could not find expected payout - %s\n", __func__, block.GetHash().ToString());
-            return false;
-        }
+    // Store txid+voutnr in database cache
+    const uint256 txHash = tx.GetHash();
+    for (uint32_t i = 0; i < vPayoutsInfo.size(); i++) {
+        PayoutInfoKey payoutInfoKey{static_cast<uint32_t>(nBlockHeight), COutPoint{txHash, i+nPayoutOffset}};
+        bettingsViewCache.payoutsInfo->Write(payoutInfoKey, *vPayoutsInfo[i]);
     }
+    if (!vPayoutsInfo.empty())
+        bettingsViewCache.SaveBettingTx(txHash, static_cast<uint32_t>(nBlockHeight));
 
     return true;
 }
@@ -434,6 +468,35 @@ bool CheckBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx, co
     return true;
 }
 
+/**
+ * Save results posted by oracle tx for using at payouts of the next block,
+ * so payouts don't need to read the block from disk.
+ */
+void SaveOracleTxResults(CBettingsView& bettingsViewCache, const CTransaction& tx, const int height)
+{
+    std::vector<CPeerlessResultDB> vPeerlessResults;
+    std::vector<CChainGamesResultDB> vChainGamesResults;
+
+    for (const CTxOut &txOut : tx.vout) {
+        auto bettingTx = ParseBettingTx(txOut);
+
+        if (bettingTx == nullptr) continue;
+
+        if (bettingTx->GetTxType() == plResultTxType) {
+            CPeerlessResultTx* resultTx = (CPeerlessResultTx *)bettingTx.get();
+            vPeerlessResults.emplace_back(resultTx->nEventId, resultTx->nResultType, resultTx->nHomeScore, resultTx->nAwayScore);
+        }
+        else if (bettingTx->GetTxType() == cgResultTxType) {
+            CChainGamesResultTx* resultTx = (CChainGamesResultTx *)bettingTx.get();
+            vChainGamesResults.emplace_back(resultTx->nEventId);
+        }
+    }
+
+    if (!vPeerlessResults.empty() || !vChainGamesResults.empty()) {
+        bettingsViewCache.SaveBlockResults(static_cast<uint32_t>(height), vPeerlessResults, vChainGamesResults);
+    }
+}
+
 void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx, const int height, const int64_t blockTime, const bool wagerrProtocolV3)
 {
     LogPrint("wagerr", "ProcessBettingTx: start, time: %lu, tx hash: %s\n", blockTime, tx.GetHash().GetHex());
@@ -441,6 +504,9 @@ void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx,
     // Ensure the event TX has come from Oracle wallet.
     const CTxIn& txin{tx.vin[0]};
     const bool validOracleTx{IsValidOracleTx(txin, height)};
+    if (validOracleTx) {
+        SaveOracleTxResults(bettingsViewCache, tx, height);
+    }
     // Get player address
     uint256 hashBlock;
     CTransaction txPrev;
@@ -542,13 +608,17 @@ void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx,
                             std::runtime_error("Unknown bet outcome type!");
                             break;
                     }
-                    if (!bettingsViewCache.events->Update(eventKey, plEvent)) {
+                    if (!bettingsViewCache.UpdateEvent(eventKey, plEvent)) {
                         // should not happen ever
                         LogPrintf("Failed to update event!\n");
                         continue;
                     }
 
-                    bettingsViewCache.bets->Write(PeerlessBetKey{static_cast<uint32_t>(height), outPoint}, CPeerlessBetDB(betAmount, address, {plBet}, {plCachedEvent}, blockTime));
+                    PeerlessBetKey betKey{static_cast<uint32_t>(height), outPoint};
+                    bettingsViewCache.bets->Write(betKey, CPeerlessBetDB(betAmount, address, {plBet}, {plCachedEvent}, blockTime));
+                    bettingsViewCache.SaveEventBets(betKey, {plBet});
+                    bettingsViewCache.SavePlayerBet(address, playerPeerlessBet, betKey);
+                    bettingsViewCache.SaveBettingTx(outPoint.hash, betKey.blockHeight);
                 }
                 else {
                     LogPrintf("Failed to find event!\n");
@@ -614,7 +684,7 @@ void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx,
                         }
 
                         lockedEvents.emplace_back(plCachedEvent);
-                        bettingsViewCache.events->Update(eventKey, plEvent);
+                        bettingsViewCache.UpdateEvent(eventKey, plEvent);
                     }
                     else {
                         LogPrintf("Failed to find event!\n");
@@ -624,7 +694,11 @@ void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx,
                 if (!legs.empty()) {
                     // save prev event state to undo
                     bettingsViewCache.SaveBettingUndo(bettingTxId, vUndos);
-                    bettingsViewCache.bets->Write(PeerlessBetKey{static_cast<uint32_t>(height), outPoint}, CPeerlessBetDB(betAmount, address, legs, lockedEvents, blockTime));
+                    PeerlessBetKey betKey{static_cast<uint32_t>(height), outPoint};
+                    bettingsViewCache.bets->Write(betKey, CPeerlessBetDB(betAmount, address, legs, lockedEvents, blockTime));
+                    bettingsViewCache.SaveEventBets(betKey, legs);
+                    bettingsViewCache.SavePlayerBet(address, playerPeerlessBet, betKey);
+                    bettingsViewCache.SaveBettingTx(outPoint.hash, betKey.blockHeight);
                 }
                 break;
             }
@@ -663,11 +737,15 @@ void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx,
                 CQuickGamesBetTx* qgBetTx = (CQuickGamesBetTx*) bettingTx.get();
 
                 LogPrint("wagerr", "CQuickGamesBetTx: gameType: %d, betInfo: %s\n", qgBetTx->gameType, std::string(qgBetTx->vBetInfo.begin(), qgBetTx->vBetInfo.end()));
+                QuickGamesBetKey qgBetKey{static_cast<uint32_t>(height), outPoint};
                 if (!bettingsViewCache.quickGamesBets->Write(
-                        QuickGamesBetKey{static_cast<uint32_t>(height), outPoint},
+                        qgBetKey,
                         CQuickGamesBetDB{ (QuickGamesType) qgBetTx->gameType, qgBetTx->vBetInfo, betAmount, address, blockTime})) {
                     LogPrintf("Failed to write bet!\n");
+                    break;
                 }
+                bettingsViewCache.SavePlayerBet(address, playerQuickGamesBet, qgBetKey);
+                bettingsViewCache.SaveBettingTx(outPoint.hash, qgBetKey.blockHeight);
                 break;
             }
 
@@ -716,7 +794,7 @@ void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx,
 
                 EventKey eventKey{plEvent.nEventId};
 
-                if (!bettingsViewCache.events->Write(eventKey, plEvent)) {
+                if (!bettingsViewCache.WriteEvent(eventKey, plEvent)) {
                     CPeerlessExtendedEventDB plEventToPatch;
                     if (!wagerrProtocolV3 &&
                             bettingsViewCache.events->Read(eventKey, plEventToPatch)) {
@@ -734,7 +812,7 @@ void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx,
                         plEventToPatch.nAwayOdds = plEvent.nAwayOdds;
                         plEventToPatch.nDrawOdds = plEvent.nDrawOdds;
 
-                        if (!bettingsViewCache.events->Update(eventKey, plEventToPatch)) {
+                        if (!bettingsViewCache.UpdateEvent(eventKey, plEventToPatch)) {
                             // should not happen ever
                             LogPrintf("Failed to update event!\n");
                         }
@@ -796,7 +874,7 @@ void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx,
                     plEvent.ExtractDataFromTx(*plUpdateOddsTx);
 
                     // Update the event in the DB.
-                    if (!bettingsViewCache.events->Update(eventKey, plEvent))
+                    if (!bettingsViewCache.UpdateEvent(eventKey, plEvent))
                         LogPrintf("Failed to update event!\n");
                 }
                 else {
@@ -870,7 +948,7 @@ void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx,
 
                     plEvent.ExtractDataFromTx(*plSpreadsEventTx);
                     // Update the event in the DB.
-                    if (!bettingsViewCache.events->Update(eventKey, plEvent))
+                    if (!bettingsViewCache.UpdateEvent(eventKey, plEvent))
                         LogPrintf("Failed to update event!\n");
                 }
                 else {
@@ -901,7 +979,7 @@ void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx,
                     plEvent.ExtractDataFromTx(*plTotalsEventTx);
 
                     // Update the event in the DB.
-                    if (!bettingsViewCache.events->Update(eventKey, plEvent))
+                    if (!bettingsViewCache.UpdateEvent(eventKey, plEvent))
                         LogPrintf("Failed to update event!\n");
                 }
                 else {
@@ -928,7 +1006,7 @@ void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx,
 
                     plEvent.ExtractDataFromTx(*plEventPatchTx);
 
-                    if (!bettingsViewCache.events->Update(eventKey, plEvent))
+                    if (!bettingsViewCache.UpdateEvent(eventKey, plEvent))
                         LogPrintf("Failed to update event!\n");
                 }
                 else {
@@ -947,10 +1025,33 @@ void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx,
     LogPrint("wagerr", "ProcessBettingTx: end\n");
 }
 
-CAmount GetBettingPayouts(CBettingsView& bettingsViewCache, const int nNewBlockHeight, std::multimap<CPayoutInfoDB, CBetOut>& mExpectedPayouts)
+/**
+ * Payouts of the last calculated block. On a staking node the same payouts are calculated
+ * in CreateNewBlock, TestBlockValidity and ConnectBlock, so keep the result together with
+ * the betting DB changes made during calculation and replay them on the next call.
+ * The changes of all the stores of the view are kept, see CBettingsView::TakeCacheChanges().
+ */
+class CBettingPayoutsCache
 {
-    if (nNewBlockHeight < Params().WagerrProtocolV2StartHeight()) return 0;
+public:
+    uint256 hashPrevBlock;
+    int nHeight = -1;
+    CAmount nExpectedMint = 0;
+    std::multimap<CPayoutInfoDB, CBetOut> mExpectedPayouts;
+    std::vector<MapKV> vChanges;
+};
+
+static CCriticalSection cs_bettingPayoutsCache;
+static std::unique_ptr<CBettingPayoutsCache> bettingPayoutsCache;
+
+void ClearBettingPayoutsCache()
+{
+    LOCK(cs_bettingPayoutsCache);
+    bettingPayoutsCache.reset();
+}
 
+CAmount CalculateBettingPayouts(CBettingsView& bettingsViewCache, const int nNewBlockHeight, std::multimap<CPayoutInfoDB, CBetOut>& mExpectedPayouts)
+{
     CAmount expectedMint = 0;
     std::vector<CBetOut> vExpectedPayouts;
     std::vector<CPayoutInfoDB> vPayoutsInfo;
@@ -968,7 +1069,7 @@ CAmount GetBettingPayouts(CBettingsView& bettingsViewCache, const int nNewBlockH
 
         GetPLBetPayoutsV3(bettingsViewCache, nNewBlockHeight, vExpectedPayouts, vPayoutsInfo);
 
-        GetCGLottoBetPayoutsV2(nNewBlockHeight, vExpectedPayouts, vPayoutsInfo);
+        GetCGLottoBetPayoutsV2(bettingsViewCache, nNewBlockHeight, vExpectedPayouts, vPayoutsInfo);
     }
 
     assert(vExpectedPayouts.size() == vPayoutsInfo.size());
@@ -981,7 +1082,47 @@ CAmount GetBettingPayouts(CBettingsView& bettingsViewCache, const int nNewBlockH
     }
 
     return expectedMint;
+}
+
+CAmount GetBettingPayouts(CBettingsView& bettingsViewCache, const int nNewBlockHeight, std::multimap<CPayoutInfoDB, CBetOut>& mExpectedPayouts)
+{
+    if (nNewBlockHeight < Params().WagerrProtocolV2StartHeight()) return 0;
 
+    // payouts are calculated for the block on top of the active chain
+    const CBlockIndex* pindexPrev = chainActive[nNewBlockHeight - 1];
+    if (!pindexPrev) {
+        return CalculateBettingPayouts(bettingsViewCache, nNewBlockHeight, mExpectedPayouts);
+    }
+    const uint256 hashPrevBlock = pindexPrev->GetBlockHash();
+
+    {
+        LOCK2(cs_bettingdb, cs_bettingPayoutsCache);
+        if (bettingPayoutsCache &&
+                bettingPayoutsCache->hashPrevBlock == hashPrevBlock &&
+                bettingPayoutsCache->nHeight == nNewBlockHeight) {
+            LogPrint("wagerr", "%s: using cached payouts for block %d\n", __func__, nNewBlockHeight);
+            // the stores of a view are cache layers, writes to them can't fail
+            bool fApplied = bettingsViewCache.ApplyCacheChanges(bettingPayoutsCache->vChanges);
+            assert(fApplied);
+            mExpectedPayouts = bettingPayoutsCache->mExpectedPayouts;
+            return bettingPayoutsCache->nExpectedMint;
+        }
+    }
+
+    // calculate payouts in separate cache layer for capturing all the betting DB changes
+    CBettingsView payoutsViewCache(&bettingsViewCache);
+    std::unique_ptr<CBettingPayoutsCache> payoutsCache(new CBettingPayoutsCache());
+    payoutsCache->hashPrevBlock = hashPrevBlock;
+    payoutsCache->nHeight = nNewBlockHeight;
+    payoutsCache->nExpectedMint = CalculateBettingPayouts(payoutsViewCache, nNewBlockHeight, payoutsCache->mExpectedPayouts);
+    payoutsCache->vChanges = payoutsViewCache.TakeCacheChanges();
+    mExpectedPayouts = payoutsCache->mExpectedPayouts;
+
+    LOCK2(cs_bettingdb, cs_bettingPayoutsCache);
+    bool fApplied = bettingsViewCache.ApplyCacheChanges(payoutsCache->vChanges);
+    assert(fApplied);
+    bettingPayoutsCache = std::move(payoutsCache);
+    return bettingPayoutsCache->nExpectedMint;
 }
 
 /*
@@ -1011,7 +1152,7 @@ bool UndoEventChanges(CBettingsView& bettingsViewCache, const BettingUndoKey& un
                             event.nDrawOdds,
                             event.fLegacyInitialHomeFavorite ? "home" : "away");
 
-            if (!bettingsViewCache.events->Update(EventKey{event.nEventId}, event))
+            if (!bettingsViewCache.UpdateEvent(EventKey{event.nEventId}, event))
                 std::runtime_error("Couldn't revert event when undo!");
         }
     }
@@ -1063,7 +1204,12 @@ bool UndoBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx, con
                     }
                     // erase bet from db
                     PeerlessBetKey key{static_cast<uint32_t>(height), outPoint};
+                    CPeerlessBetDB plBetDB;
+                    if (bettingsViewCache.bets->Read(key, plBetDB))
+                        bettingsViewCache.ErasePlayerBet(plBetDB.playerAddress, playerPeerlessBet, key);
                     bettingsViewCache.bets->Erase(key);
+                    bettingsViewCache.EraseBettingTx(outPoint.hash);
+                    bettingsViewCache.EraseEventBets(key, {plBet});
                 }
                 else {
                     LogPrintf("Failed to find event!\n");
@@ -1101,7 +1247,12 @@ bool UndoBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx, con
                     }
                     // erase bet from db
                     PeerlessBetKey key{static_cast<uint32_t>(height), outPoint};
+                    CPeerlessBetDB parlayBetDB;
+                    if (bettingsViewCache.bets->Read(key, parlayBetDB))
+                        bettingsViewCache.ErasePlayerBet(parlayBetDB.playerAddress, playerPeerlessBet, key);
                     bettingsViewCache.bets->Erase(key);
+                    bettingsViewCache.EraseBettingTx(outPoint.hash);
+                    bettingsViewCache.EraseEventBets(key, legs);
                 }
 
                 break;
@@ -1133,10 +1284,15 @@ bool UndoBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx, con
 
                 LogPrintf("CQuickGamesBetTx: gameType: %d, betInfo: %s\n", qgBetTx->gameType, std::string(qgBetTx->vBetInfo.begin(), qgBetTx->vBetInfo.end()));
 
-                if (!bettingsViewCache.quickGamesBets->Erase(QuickGamesBetKey{static_cast<uint32_t>(height), outPoint})) {
+                QuickGamesBetKey qgBetKey{static_cast<uint32_t>(height), outPoint};
+                CQuickGamesBetDB qgBetDB;
+                if (bettingsViewCache.quickGamesBets->Read(qgBetKey, qgBetDB))
+                    bettingsViewCache.ErasePlayerBet(qgBetDB.playerAddress, playerQuickGamesBet, qgBetKey);
+                if (!bettingsViewCache.quickGamesBets->Erase(qgBetKey)) {
                     LogPrintf("Revert failed!\n");
                     return false;
                 }
+                bettingsViewCache.EraseBettingTx(outPoint.hash);
                 break;
             }
 
@@ -1185,7 +1341,7 @@ bool UndoBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx, con
                             return false;
                         }
                     }
-                    else if (!bettingsViewCache.events->Erase(EventKey{plEventTx->nEventId})) {
+                    else if (!bettingsViewCache.EraseEvent(EventKey{plEventTx->nEventId})) {
                         LogPrintf("Revert failed!\n");
                         return false;
                     }
@@ -1343,9 +1499,31 @@ bool UndoBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx, con
  */
 bool UndoBetPayouts(CBettingsView &bettingsViewCache, int height)
 {
+    // bets completed by payouts of the block are recorded when it is connected
+    std::vector<PeerlessBetKey> vCompletedBets;
+    if (bettingsViewCache.GetCompletedBets(static_cast<uint32_t>(height), vCompletedBets)) {
+        LOCK(cs_bettingdb);
+
+        LogPrintf("Start undo payouts of %lu bets...\n", vCompletedBets.size());
+
+        for (const PeerlessBetKey& uniBetKey : vCompletedBets) {
+            CPeerlessBetDB uniBet;
+            if (!bettingsViewCache.bets->Read(uniBetKey, uniBet)) {
+                LogPrintf("%s - Failed to find completed bet %s\n", __func__, uniBetKey.outPoint.ToStringShort());
+                return false;
+            }
+            uniBet.SetUncompleted();
+            uniBet.resultType = BetResultType::betResultUnknown;
+            uniBet.payout = 0;
+            bettingsViewCache.bets->Update(uniBetKey, uniBet);
+        }
+        return bettingsViewCache.EraseCompletedBets(static_cast<uint32_t>(height));
+    }
+
+    // blocks connected by older versions, look for the bets of the results
     int nCurrentHeight = chainActive.Height();
     // Get all the results posted in the previous block.
-    std::vector<CPeerlessResultDB> results = GetEventResults(height - 1);
+    std::vector<CPeerlessResultDB> results = GetEventResults(bettingsViewCache, height - 1);
 
     LogPrintf("Start undo payouts...\n");
 
@@ -1360,8 +1538,8 @@ bool UndoBetPayouts(CBettingsView &bettingsViewCache, int height)
         for (it->Seek(CBettingDB::DbTypeToBytes(PeerlessBetKey{startHeight, COutPoint()})); it->Valid(); it->Next()) {
             PeerlessBetKey uniBetKey;
             CPeerlessBetDB uniBet;
-            CBettingDB::BytesToDbType(it->Key(), uniBetKey);
-            CBettingDB::BytesToDbType(it->Value(), uniBet);
+            CBettingDB::BytesToDbType(it->KeySlice(), uniBetKey);
+            CBettingDB::BytesToDbType(it->ValueSlice(), uniBet);
             // skip if bet is uncompleted
             if (!uniBet.IsCompleted()) continue;
 
@@ -1412,6 +1590,37 @@ bool UndoBetPayouts(CBettingsView &bettingsViewCache, int height)
     return true;
 }
 
+/* Revert resolution of parlay legs made by payouts of the block */
+bool UndoParlayLegs(CBettingsView &bettingsViewCache, int height)
+{
+    const int nLastBlockHeight = height - 1;
+    if (nLastBlockHeight < Params().WagerrProtocolV3StartHeight()) return true;
+
+    // legs are resolved only for parlays placed since the start height
+    const uint32_t nParlayLegsStartHeight = bettingsViewCache.GetParlayLegsStartHeight();
+    if (nParlayLegsStartHeight > (uint32_t) nLastBlockHeight) return true;
+    uint32_t startHeight = std::max(GetBetSearchStartHeight(nLastBlockHeight), nParlayLegsStartHeight);
+
+    LOCK(cs_bettingdb);
+
+    for (const CPeerlessResultDB& result : GetEventResults(bettingsViewCache, nLastBlockHeight)) {
+        for (const PeerlessBetKey& betKey : bettingsViewCache.GetEventBets(result.nEventId, startHeight)) {
+            CParlayLegsDB parlayLegs;
+            if (!bettingsViewCache.parlayLegs->Read(betKey, parlayLegs)) continue;
+            bool fChanged = false;
+            for (size_t idx = 0; idx < parlayLegs.vLegs.size(); idx++) {
+                if (parlayLegs.vLegs[idx].nResolveHeight == (uint32_t) height) {
+                    parlayLegs.UnresolveLeg(idx);
+                    fChanged = true;
+                }
+            }
+            if (fChanged && !bettingsViewCache.SaveParlayLegs(betKey, parlayLegs))
+                return false;
+        }
+    }
+    return true;
+}
+
 /* Revert payouts info from DB */
 bool UndoPayoutsInfo(CBettingsView &bettingsViewCache, int height)
 {
@@ -1423,7 +1632,7 @@ bool UndoPayoutsInfo(CBettingsView &bettingsViewCache, int height)
     auto it = bettingsViewCache.payoutsInfo->NewIterator();
     for (it->Seek(CBettingDB::DbTypeToBytes(PayoutInfoKey{static_cast<uint32_t>(height), COutPoint()})); it->Valid(); it->Next()) {
         PayoutInfoKey key;
-        CBettingDB::BytesToDbType(it->Key(), key);
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
         if ((int64_t)key.blockHeight != height)
             break;
         else
@@ -1434,6 +1643,7 @@ bool UndoPayoutsInfo(CBettingsView &bettingsViewCache, int height)
     for (auto&& key : entriesToDelete) {
         if (!bettingsViewCache.payoutsInfo->Erase(key))
             return false;
+        bettingsViewCache.EraseBettingTx(key.outPoint.hash);
     }
 
     return true;
@@ -1457,8 +1667,8 @@ bool UndoQuickGamesBetPayouts(CBettingsView &bettingsViewCache, int height)
     for (it->Seek(CBettingDB::DbTypeToBytes(QuickGamesBetKey{blockHeight, COutPoint()})); it->Valid(); it->Next()) {
         QuickGamesBetKey qgBetKey;
         CQuickGamesBetDB qgBet;
-        CBettingDB::BytesToDbType(it->Key(), qgBetKey);
-        CBettingDB::BytesToDbType(it->Value(), qgBet);
+        CBettingDB::BytesToDbType(it->KeySlice(), qgBetKey);
+        CBettingDB::BytesToDbType(it->ValueSlice(), qgBet);
         // skip if bet is uncompleted
         if (!qgBet.IsCompleted()) continue;
 
@@ -1475,6 +1685,9 @@ bool UndoQuickGamesBetPayouts(CBettingsView &bettingsViewCache, int height)
 
 bool BettingUndo(CBettingsView& bettingsViewCache, int height, const std::vector<CTransaction>& vtx)
 {
+    // memoized payouts could be calculated at disconnecting chain
+    ClearBettingPayoutsCache();
+
         // Revert betting dats
     if (height > Params().WagerrProtocolV2StartHeight()) {
         // revert complete bet payouts marker
@@ -1482,6 +1695,10 @@ bool BettingUndo(CBettingsView& bettingsViewCache, int height, const std::vector
             error("DisconnectBlock(): undo payout data is inconsistent");
             return false;
         }
+        if (!UndoParlayLegs(bettingsViewCache, height)) {
+            error("DisconnectBlock(): undo of parlay legs resolution failed");
+            return false;
+        }
         if (!UndoQuickGamesBetPayouts(bettingsViewCache, height)) {
             error("DisconnectBlock(): undo payout data for quick games bets is inconsistent");
             return false;
@@ -1490,6 +1707,10 @@ bool BettingUndo(CBettingsView& bettingsViewCache, int height, const std::vector
             error("DisconnectBlock(): undo payouts info failed");
             return false;
         }
+        if (!bettingsViewCache.EraseBlockResults(height)) {
+            error("DisconnectBlock(): undo block results failed");
+            return false;
+        }
 
         // undo betting txs in back order
         for (auto it = vtx.crbegin(); it != vtx.crend(); it++) {
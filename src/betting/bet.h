@@ -12,12 +12,16 @@ class CBettingsView;
 class CPayoutInfoDB;
 class CBetOut;
 class CTransaction;
+class CTxOut;
 class CBlock;
 
 extern CBettingsView *bettingsView;
 
+/** Pair every found payout with the info of an expected payout of equal value and script, in a single pass. **/
+bool MatchExpectedPayouts(const std::multimap<CPayoutInfoDB, CBetOut>& mExpectedPayouts, const std::vector<CTxOut>& vFoundPayouts, std::vector<const CPayoutInfoDB*>& vPayoutsInfo);
+
 /** Validating the payout block using the payout vector. **/
-bool IsBlockPayoutsValid(CBettingsView &bettingsViewCache, const std::multimap<CPayoutInfoDB, CBetOut>& mExpectedPayoutsIn, const CBlock& block, const int nBlockHeight, const CAmount& nExpectedMint, const CAmount& nExpectedMNReward);
+bool IsBlockPayoutsValid(CBettingsView &bettingsViewCache, const std::multimap<CPayoutInfoDB, CBetOut>& mExpectedPayouts, const CBlock& block, const int nBlockHeight, const CAmount& nExpectedMint, const CAmount& nExpectedMNReward);
 
 /** Check Betting Tx when try accept tx to memory pool **/
 bool CheckBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx, const int height);
@@ -25,8 +29,12 @@ bool CheckBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx, co
 /** Parse the transaction for betting data **/
 void ProcessBettingTx(CBettingsView& bettingsViewCache, const CTransaction& tx, const int height, const int64_t blockTime, const bool wagerrProtocolV3);
 
+/** Get the payouts of the block with given height, memoized per previous block hash **/
 CAmount GetBettingPayouts(CBettingsView& bettingsViewCache, const int nNewBlockHeight, std::multimap<CPayoutInfoDB, CBetOut>& mExpectedPayouts);
 
+/** Drop memoized payouts, should be called when betting state is changed out of block connecting **/
+void ClearBettingPayoutsCache();
+
 bool BettingUndo(CBettingsView& bettingsViewCache, int height, const std::vector<CTransaction>& vtx);
 
 #endif // WAGERR_BET_H
@@ -17,14 +17,12 @@
 bool IsValidOracleTx(const CTxIn &txin, int nHeight)
 {
     COutPoint prevout = txin.prevout;
-    std::vector<COracle> oracles = Params().Oracles();
 
     uint256 hashBlock;
     CTransaction txPrev;
     if (GetTransaction(prevout.hash, txPrev, hashBlock, true)) {
 
         const CTxOut &prevTxOut = txPrev.vout[prevout.n];
-        std::string scriptPubKey = prevTxOut.scriptPubKey.ToString();
 
         txnouttype type;
         std::vector<CTxDestination> prevAddrs;
@@ -32,10 +30,9 @@ bool IsValidOracleTx(const CTxIn &txin, int nHeight)
 
         if (ExtractDestinations(prevTxOut.scriptPubKey, type, prevAddrs, nRequired)) {
             for (const CTxDestination &prevAddr : prevAddrs) {
-                const std::string strPrevAddr = CBitcoinAddress(prevAddr).ToString();
-                if (std::find_if(oracles.begin(), oracles.end(), [strPrevAddr, nHeight](COracle oracle){
-                    return oracle.IsMyOracleTx(strPrevAddr, nHeight);
-                }) != oracles.end()) {
+                // Oracle addresses are pay-to-pubkey-hash, so only key ids can match them.
+                const CKeyID* prevKeyID = boost::get<CKeyID>(&prevAddr);
+                if (prevKeyID && IsOracleKeyID(*prevKeyID, nHeight)) {
                     return true;
                 }
             }
@@ -75,12 +72,22 @@ bool CalculatePayoutBurnAmounts(const CAmount betAmount, const uint32_t odds, CA
  *
  * @return results vector.
  */
-std::vector<CPeerlessResultDB> GetEventResults(int nLastBlockHeight)
+std::vector<CPeerlessResultDB> GetEventResults(CBettingsView& bettingsViewCache, int nLastBlockHeight)
 {
     std::vector<CPeerlessResultDB> results;
 
     bool fMultipleResultsAllowed = (nLastBlockHeight >= Params().WagerrProtocolV3StartHeight());
 
+    // Use the results recorded when the block was connected.
+    CBlockResultsDB blockResults;
+    if (bettingsViewCache.GetBlockResults(nLastBlockHeight, blockResults)) {
+        results = blockResults.vPeerlessResults;
+        if (!fMultipleResultsAllowed && results.size() > 1) {
+            results.resize(1);
+        }
+        return results;
+    }
+
     // Get the current block so we can look for any results in it.
     CBlockIndex *resultsBocksIndex = NULL;
     resultsBocksIndex = chainActive[nLastBlockHeight];
@@ -121,10 +128,17 @@ std::vector<CPeerlessResultDB> GetEventResults(int nLastBlockHeight)
  * @param height The block we want to check for the result.
  * @return results array.
  */
-bool GetCGLottoEventResults(const int nLastBlockHeight, std::vector<CChainGamesResultDB>& chainGameResults)
+bool GetCGLottoEventResults(CBettingsView& bettingsViewCache, const int nLastBlockHeight, std::vector<CChainGamesResultDB>& chainGameResults)
 {
     chainGameResults.clear();
 
+    // Use the results recorded when the block was connected.
+    CBlockResultsDB blockResults;
+    if (bettingsViewCache.GetBlockResults(nLastBlockHeight, blockResults)) {
+        chainGameResults = blockResults.vChainGamesResults;
+        return (chainGameResults.size() > 0);
+    }
+
     // Get the current block so we can look for any results in it.
     CBlockIndex *resultsBocksIndex = chainActive[nLastBlockHeight];
 
@@ -15,6 +15,7 @@ class CChainGamesResultDB;
 class CPeerlessLegDB;
 class CPeerlessBaseEventDB;
 class CPayoutInfoDB;
+class CBettingsView;
 
 #define BET_ODDSDIVISOR 10000   // Odds divisor, Facilitates calculations with floating integers.
 #define BET_BURNXPERMILLE 60    // Burn promillage
@@ -164,10 +165,10 @@ bool IsValidOracleTx(const CTxIn &txin, int nHeight);
 bool CalculatePayoutBurnAmounts(const CAmount betAmount, const uint32_t odds, CAmount& nPayout, CAmount& nBurn);
 
 /** Find peerless events. **/
-std::vector<CPeerlessResultDB> GetEventResults(int nLastBlockHeight);
+std::vector<CPeerlessResultDB> GetEventResults(CBettingsView& bettingsViewCache, int nLastBlockHeight);
 
 /** Find chain games lotto result. **/
-bool GetCGLottoEventResults(const int nLastBlockHeight, std::vector<CChainGamesResultDB>& chainGameResults);
+bool GetCGLottoEventResults(CBettingsView& bettingsViewCache, const int nLastBlockHeight, std::vector<CChainGamesResultDB>& chainGameResults);
 
 /**
  * Check winning condition for current bet considering locked event and event result.
@@ -57,6 +57,27 @@ std::unique_ptr<CStorageKVIterator> CBettingDB::NewIterator()
     return db.NewIterator();
 }
 
+void CBettingDB::Clear()
+{
+    // keys are erased and flushed in bounded batches, the next batch is sought after the last erased key
+    static const size_t nBatchSize = 10000;
+    std::vector<std::vector<unsigned char>> vKeys;
+    do {
+        std::vector<unsigned char> startKey = vKeys.empty() ? std::vector<unsigned char>{} : vKeys.back();
+        vKeys.clear();
+        {
+            auto it = db.NewIterator();
+            for (it->Seek(startKey); it->Valid() && vKeys.size() < nBatchSize; it->Next()) {
+                vKeys.emplace_back(it->Key());
+            }
+        }
+        for (const auto& key : vKeys) {
+            db.Erase(key);
+        }
+        db.Flush();
+    } while (vKeys.size() == nBatchSize);
+}
+
 unsigned int CBettingDB::GetCacheSize()
 {
     return db.GetCacheSize();
@@ -67,6 +88,21 @@ unsigned int CBettingDB::GetCacheSizeBytesToWrite()
     return db.GetCacheSizeBytesToWrite();
 }
 
+const MapKV& CBettingDB::GetCacheChanges()
+{
+    return db.GetRaw();
+}
+
+MapKV CBettingDB::TakeCacheChanges()
+{
+    return db.TakeRaw();
+}
+
+bool CBettingDB::ApplyCacheChanges(const MapKV& changes)
+{
+    return db.WriteBatch(changes);
+}
+
 size_t CBettingDB::dbWrapperCacheSize()
 {
     return 10 << 20;
@@ -91,74 +127,316 @@ using namespace boost::filesystem;
     return result;
 }
 
+/*
+ * CMappingNames methods
+ */
+
+void CMappingNames::Load(CBettingDB& mappings)
+{
+    mapNames.clear();
+    mapIds.clear();
+    auto it = mappings.NewIterator();
+    for (it->Seek(std::vector<unsigned char>{}); it->Valid(); it->Next()) {
+        MappingKey key;
+        CMappingDB mapping;
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
+        CBettingDB::BytesToDbType(it->ValueSlice(), mapping);
+        Insert(key, mapping.sName);
+    }
+}
+
+void CMappingNames::ApplyChanges(const MapKV& changes)
+{
+    for (const auto& change : changes) {
+        MappingKey key;
+        CBettingDB::BytesToDbType(CStorageKVSlice{change.first}, key);
+        Remove(key);
+        if (change.second) {
+            CMappingDB mapping;
+            CBettingDB::BytesToDbType(CStorageKVSlice{*change.second}, mapping);
+            Insert(key, mapping.sName);
+        }
+    }
+}
+
+bool CMappingNames::GetName(const MappingKey& key, std::string& name) const
+{
+    auto it = mapNames.find(std::make_pair((uint32_t) key.nMType, key.nId));
+    if (it == mapNames.end())
+        return false;
+    name = it->second;
+    return true;
+}
+
+bool CMappingNames::GetId(const MappingType type, const std::string& name, uint32_t& id) const
+{
+    auto it = mapIds.find(std::make_pair((uint32_t) type, name));
+    if (it == mapIds.end())
+        return false;
+    id = *it->second.begin();
+    return true;
+}
+
+void CMappingNames::Insert(const MappingKey& key, const std::string& name)
+{
+    mapNames[std::make_pair((uint32_t) key.nMType, key.nId)] = name;
+    mapIds[std::make_pair((uint32_t) key.nMType, name)].insert(key.nId);
+}
+
+void CMappingNames::Remove(const MappingKey& key)
+{
+    auto it = mapNames.find(std::make_pair((uint32_t) key.nMType, key.nId));
+    if (it == mapNames.end())
+        return;
+    auto itIds = mapIds.find(std::make_pair((uint32_t) key.nMType, it->second));
+    if (itIds != mapIds.end()) {
+        itIds->second.erase(key.nId);
+        if (itIds->second.empty())
+            mapIds.erase(itIds);
+    }
+    mapNames.erase(it);
+}
+
+/*
+ * CUpcomingEvents methods
+ */
+
+static bool ResolveEventNames(CUpcomingEvent& event, const CMappingNames& names)
+{
+    return names.GetName(MappingKey{sportMapping, event.nSport}, event.sSport) &&
+            names.GetName(MappingKey{tournamentMapping, event.nTournament}, event.sTournament) &&
+            names.GetName(MappingKey{teamMapping, event.nHomeTeam}, event.sHomeTeam) &&
+            names.GetName(MappingKey{teamMapping, event.nAwayTeam}, event.sAwayTeam);
+}
+
+void CUpcomingEvents::Load(CBettingDB& events, CBettingDB& eventStartTimes, const uint64_t startTime, const CMappingNames& names)
+{
+    mapEvents.clear();
+    nStartTime = startTime;
+    auto it = eventStartTimes.NewIterator();
+    for (it->Seek(CBettingDB::DbTypeToBytes(EventStartKey{startTime, 0})); it->Valid(); it->Next()) {
+        EventStartKey key;
+        CPeerlessExtendedEventDB event;
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
+        if (events.Read(EventKey{key.eventId}, event))
+            Insert(event, names);
+    }
+}
+
+void CUpcomingEvents::ApplyChanges(const MapKV& changes, const CMappingNames& names)
+{
+    for (const auto& change : changes) {
+        EventKey key{0};
+        CBettingDB::BytesToDbType(CStorageKVSlice{change.first}, key);
+        mapEvents.erase(key.eventId);
+        if (change.second) {
+            CPeerlessExtendedEventDB event;
+            CBettingDB::BytesToDbType(CStorageKVSlice{*change.second}, event);
+            Insert(event, names);
+        }
+    }
+}
+
+/**
+ * Resolve the names again, called when the mappings have changed.
+ */
+void CUpcomingEvents::ResolveNames(const CMappingNames& names)
+{
+    for (auto& it : mapEvents)
+        it.second.fNamesResolved = ResolveEventNames(it.second, names);
+}
+
+/**
+ * Drop the events started before startTime and return the rest, ordered by event id.
+ */
+std::vector<CUpcomingEvent> CUpcomingEvents::Get(const uint64_t startTime)
+{
+    if (startTime > nStartTime) {
+        nStartTime = startTime;
+        for (auto it = mapEvents.begin(); it != mapEvents.end();) {
+            if (it->second.nStartTime < nStartTime)
+                it = mapEvents.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    std::vector<CUpcomingEvent> vEvents;
+    vEvents.reserve(mapEvents.size());
+    for (const auto& it : mapEvents) {
+        if (it.second.nStartTime >= startTime)
+            vEvents.emplace_back(it.second);
+    }
+    return vEvents;
+}
+
+void CUpcomingEvents::Insert(const CPeerlessExtendedEventDB& event, const CMappingNames& names)
+{
+    if (event.nStartTime < nStartTime)
+        return;
+    CUpcomingEvent& upcoming = mapEvents[event.nEventId];
+    upcoming = CUpcomingEvent(event);
+    upcoming.fNamesResolved = ResolveEventNames(upcoming, names);
+}
+
 /*
  * CBettingsView methods
  */
 
 // copy constructor for creating DB cache
-CBettingsView::CBettingsView(CBettingsView* phr) {
+CBettingsView::CBettingsView(CBettingsView* phr) : parentView(phr) {
     mappings = MakeUnique<CBettingDB>(*phr->mappings.get());
     results = MakeUnique<CBettingDB>(*phr->results.get());
     events = MakeUnique<CBettingDB>(*phr->events.get());
+    eventStartTimes = MakeUnique<CBettingDB>(*phr->eventStartTimes.get());
     bets = MakeUnique<CBettingDB>(*phr->bets.get());
+    eventBets = MakeUnique<CBettingDB>(*phr->eventBets.get());
+    playerBets = MakeUnique<CBettingDB>(*phr->playerBets.get());
+    bettingTxs = MakeUnique<CBettingDB>(*phr->bettingTxs.get());
     undos = MakeUnique<CBettingDB>(*phr->undos.get());
+    undoHeights = MakeUnique<CBettingDB>(*phr->undoHeights.get());
     payoutsInfo = MakeUnique<CBettingDB>(*phr->payoutsInfo.get());
     quickGamesBets = MakeUnique<CBettingDB>(*phr->quickGamesBets.get());
     chainGamesLottoEvents = MakeUnique<CBettingDB>(*phr->chainGamesLottoEvents.get());
     chainGamesLottoBets = MakeUnique<CBettingDB>(*phr->chainGamesLottoBets.get());
     chainGamesLottoResults = MakeUnique<CBettingDB>(*phr->chainGamesLottoResults.get());
+    blockResults = MakeUnique<CBettingDB>(*phr->blockResults.get());
+    completedBets = MakeUnique<CBettingDB>(*phr->completedBets.get());
+    parlayLegs = MakeUnique<CBettingDB>(*phr->parlayLegs.get());
     failedBettingTxs = MakeUnique<CBettingDB>(*phr->failedBettingTxs.get());
 }
 
 bool CBettingsView::Flush() {
     LOCK(cs_bettingdb);
 
-    return mappings->Flush() &&
-            results->Flush() &&
-            events->Flush() &&
+    // keep the dictionary of the global view consistent with its mappings DB,
+    // the changes are copied because the flush clears them
+    const bool fMappingNames = parentView && parentView->mappingNames;
+    MapKV mappingChanges;
+    if (fMappingNames)
+        mappingChanges = mappings->GetCacheChanges();
+    if (!mappings->Flush())
+        return false;
+    if (fMappingNames)
+        parentView->mappingNames->ApplyChanges(mappingChanges);
+    if (fMappingNames && parentView->upcomingEvents && !mappingChanges.empty())
+        parentView->upcomingEvents->ResolveNames(*parentView->mappingNames);
+
+    // the same for the upcoming events, after the mapping names are updated
+    const bool fUpcomingEvents = fMappingNames && parentView->upcomingEvents;
+    MapKV eventChanges;
+    if (fUpcomingEvents)
+        eventChanges = events->GetCacheChanges();
+    if (!events->Flush())
+        return false;
+    if (fUpcomingEvents)
+        parentView->upcomingEvents->ApplyChanges(eventChanges, *parentView->mappingNames);
+
+    // block results hold the IndexedBlock mark, flush them last so that an interrupted
+    // flush leaves the indexes marked as not synced and they are rebuilt on startup
+    return results->Flush() &&
+            eventStartTimes->Flush() &&
             bets->Flush() &&
+            eventBets->Flush() &&
+            playerBets->Flush() &&
+            bettingTxs->Flush() &&
             undos->Flush() &&
+            undoHeights->Flush() &&
             payoutsInfo->Flush() &&
             quickGamesBets->Flush() &&
             chainGamesLottoEvents->Flush() &&
             chainGamesLottoBets->Flush() &&
-            chainGamesLottoResults->Flush();
+            chainGamesLottoResults->Flush() &&
+            completedBets->Flush() &&
+            parlayLegs->Flush() &&
+            blockResults->Flush();
             failedBettingTxs->Flush();
 }
 
 unsigned int CBettingsView::GetCacheSize() {
     LOCK(cs_bettingdb);
 
-    return mappings->GetCacheSize() +
-            results->GetCacheSize() +
-            events->GetCacheSize() +
-            bets->GetCacheSize() +
-            undos->GetCacheSize() +
-            payoutsInfo->GetCacheSize() +
-            quickGamesBets->GetCacheSize() +
-            chainGamesLottoEvents->GetCacheSize() +
-            chainGamesLottoBets->GetCacheSize() +
-            chainGamesLottoResults->GetCacheSize() +
-            failedBettingTxs->GetCacheSize();
+    unsigned int size = 0;
+    for (CBettingDB* store : GetStores())
+        size += store->GetCacheSize();
+    return size;
 }
 
 unsigned int CBettingsView::GetCacheSizeBytesToWrite() {
     LOCK(cs_bettingdb);
 
-    return mappings->GetCacheSizeBytesToWrite() +
-            results->GetCacheSizeBytesToWrite() +
-            events->GetCacheSizeBytesToWrite() +
-            bets->GetCacheSizeBytesToWrite() +
-            undos->GetCacheSizeBytesToWrite() +
-            payoutsInfo->GetCacheSizeBytesToWrite() +
-            quickGamesBets->GetCacheSizeBytesToWrite() +
-            chainGamesLottoEvents->GetCacheSizeBytesToWrite() +
-            chainGamesLottoBets->GetCacheSizeBytesToWrite() +
-            chainGamesLottoResults->GetCacheSizeBytesToWrite() +
-            failedBettingTxs->GetCacheSizeBytesToWrite();
+    unsigned int size = 0;
+    for (CBettingDB* store : GetStores())
+        size += store->GetCacheSizeBytesToWrite();
+    return size;
 }
 
-void CBettingsView::SetLastHeight(uint32_t height) {
+std::vector<CBettingDB*> CBettingsView::GetStores() {
+    return {
+        mappings.get(),
+        results.get(),
+        events.get(),
+        eventStartTimes.get(),
+        bets.get(),
+        eventBets.get(),
+        playerBets.get(),
+        bettingTxs.get(),
+        undos.get(),
+        undoHeights.get(),
+        payoutsInfo.get(),
+        quickGamesBets.get(),
+        chainGamesLottoEvents.get(),
+        chainGamesLottoBets.get(),
+        chainGamesLottoResults.get(),
+        blockResults.get(),
+        completedBets.get(),
+        parlayLegs.get(),
+        failedBettingTxs.get(),
+    };
+}
+
+/**
+ * Move the changes of all the stores out of the view, used for capturing of the changes
+ * made by a calculation in a separate cache layer.
+ */
+std::vector<MapKV> CBettingsView::TakeCacheChanges() {
+    LOCK(cs_bettingdb);
+
+    std::vector<MapKV> changes;
+    for (CBettingDB* store : GetStores())
+        changes.emplace_back(store->TakeCacheChanges());
+    return changes;
+}
+
+/**
+ * Write changes taken by TakeCacheChanges() of a view into the caches of the stores.
+ */
+bool CBettingsView::ApplyCacheChanges(const std::vector<MapKV>& changes) {
+    LOCK(cs_bettingdb);
+
+    std::vector<CBettingDB*> stores = GetStores();
+    assert(stores.size() == changes.size());
+    bool fOk = true;
+    for (size_t i = 0; i < stores.size(); i++)
+        fOk = stores[i]->ApplyCacheChanges(changes[i]) && fOk;
+    // mappings are the first store, keep the dictionary of the global view consistent with them
+    if (fOk && mappingNames)
+        mappingNames->ApplyChanges(changes.front());
+    if (fOk && mappingNames && upcomingEvents) {
+        size_t nEvents = std::find(stores.begin(), stores.end(), events.get()) - stores.begin();
+        if (!changes.front().empty())
+            upcomingEvents->ResolveNames(*mappingNames);
+        upcomingEvents->ApplyChanges(changes[nEvents], *mappingNames);
+    }
+    return fOk;
+}
+
+/**
+ * Set the last connected block, the block hash marks that secondary indexes
+ * and per block records are synced with it. The mark is kept in the block results DB,
+ * which is unknown to older versions, so they never read it as an undo or bet key.
+ */
+void CBettingsView::SetLastHeight(uint32_t height, const uint256& hashBlock) {
     LOCK(cs_bettingdb);
 
     if (!undos->Exists(std::string("LastHeight"))) {
@@ -167,6 +445,7 @@ void CBettingsView::SetLastHeight(uint32_t height) {
     else {
         undos->Update(std::string("LastHeight"), height);
     }
+    SetIndexedBlock(hashBlock);
 }
 
 uint32_t CBettingsView::GetLastHeight() {
@@ -178,16 +457,81 @@ uint32_t CBettingsView::GetLastHeight() {
     return height;
 }
 
+void CBettingsView::SetIndexedBlock(const uint256& hashBlock) {
+    if (!blockResults->Exists(std::string("IndexedBlock"))) {
+        blockResults->Write(std::string("IndexedBlock"), hashBlock);
+    }
+    else {
+        blockResults->Update(std::string("IndexedBlock"), hashBlock);
+    }
+}
+
+/**
+ * Check that the betting DBs are marked as synced with the block at their last height.
+ * The mark is flushed after the last height and the other DBs, so the check doesn't depend on the chainstate flush.
+ * @param hashLastBlock hash of the active chain block at GetLastHeight().
+ */
+bool CBettingsView::IndexesSynced(const uint256& hashLastBlock) {
+    LOCK(cs_bettingdb);
+
+    // nothing was connected yet, all the DBs are empty
+    if (!undos->Exists(std::string("LastHeight")))
+        return true;
+
+    uint256 hashIndexed;
+    return blockResults->Read(std::string("IndexedBlock"), hashIndexed) && hashIndexed == hashLastBlock;
+}
+
+/**
+ * Rebuild secondary indexes and restart per block records, used when blocks were connected
+ * by an older version, which doesn't maintain them.
+ * @param hashLastBlock hash of the active chain block at GetLastHeight().
+ */
+void CBettingsView::RebuildIndexes(const uint256& hashLastBlock) {
+    LOCK(cs_bettingdb);
+
+    uint256 hashIndexed;
+    blockResults->Read(std::string("IndexedBlock"), hashIndexed);
+    LogPrintf("%s: betting indexes are marked as synced with block %s, but the block at betting height %lu is %s "
+              "(blocks were connected or disconnected by an older version), rebuilding the indexes\n",
+              __func__, hashIndexed.ToString(), GetLastHeight(), hashLastBlock.ToString());
+    RebuildIndex(*eventStartTimes, "events by start time", [this] { return ReindexEventStartTimes(); });
+    RebuildIndex(*eventBets, "bets by event", [this] { return ReindexEventBets(); });
+    RebuildIndex(*playerBets, "bets by player", [this] { return ReindexPlayerBets(); });
+    RebuildIndex(*bettingTxs, "bets and payouts by txid", [this] { return ReindexBettingTxs(); });
+    RebuildIndex(*undoHeights, "undos by height", [this] { return ReindexUndoHeights(); });
+
+    // records are restarted from the next block by Init* calls, older blocks use the fallbacks
+    for (CBettingDB* db : {blockResults.get(), completedBets.get(), parlayLegs.get()}) {
+        db->Clear();
+    }
+
+    SetIndexedBlock(hashLastBlock);
+    blockResults->Flush();
+}
+
+void CBettingsView::RebuildIndex(CBettingDB& index, const char* desc, std::function<uint32_t()> fnBuild) {
+    index.Clear();
+    uint32_t count = fnBuild();
+    index.Flush();
+    LogPrintf("%s: indexed %lu %s\n", __func__, count, desc);
+}
+
 bool CBettingsView::SaveBettingUndo(const BettingUndoKey& key, std::vector<CBettingUndoDB> vUndos) {
     LOCK(cs_bettingdb);
 
     assert(!undos->Exists(key));
+    if (!vUndos.empty())
+        undoHeights->Write(UndoHeightKey{vUndos[0].height, key}, 0);
     return undos->Write(key, vUndos);
 }
 
 bool CBettingsView::EraseBettingUndo(const BettingUndoKey& key) {
     LOCK(cs_bettingdb);
 
+    std::vector<CBettingUndoDB> vUndos;
+    if (undos->Read(key, vUndos) && !vUndos.empty())
+        undoHeights->Erase(UndoHeightKey{vUndos[0].height, key});
     return undos->Erase(key);
 }
 
@@ -210,26 +554,47 @@ bool CBettingsView::ExistsBettingUndo(const BettingUndoKey& key) {
 void CBettingsView::PruneOlderUndos(const uint32_t height) {
     LOCK(cs_bettingdb);
 
+    // undos are indexed by height, so only the range below the height is visited
+    auto it = undoHeights->NewIterator();
+    std::vector<UndoHeightKey> vKeysToDelete;
+    for (it->Seek(std::vector<unsigned char>{}); it->Valid(); it->Next()) {
+        UndoHeightKey key;
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
+        if (key.height >= height)
+            break;
+        vKeysToDelete.push_back(key);
+    }
+    for (auto && key : vKeysToDelete) {
+        undos->Erase(key.undoKey);
+        undoHeights->Erase(key);
+    }
+}
+
+/**
+ * Build undo heights index from undos DB.
+ * @return number of the indexed undos.
+ */
+uint32_t CBettingsView::ReindexUndoHeights() {
+    LOCK(cs_bettingdb);
+
     static std::vector<unsigned char> lastHeightKey = CBettingDB::DbTypeToBytes(std::string("LastHeight"));
-    std::vector<CBettingUndoDB> vUndos;
-    BettingUndoKey key;
-    std::string str;
+    uint32_t count = 0;
     auto it = undos->NewIterator();
-    std::vector<BettingUndoKey> vKeysToDelete;
     for (it->Seek(std::vector<unsigned char>{}); it->Valid(); it->Next()) {
         // check that key is serialized "LastHeight" key and skip if true
-        if (it->Key() == lastHeightKey) {
+        if (it->KeySlice() == lastHeightKey) {
             continue;
         }
-        CBettingDB::BytesToDbType(it->Key(), key);
-        CBettingDB::BytesToDbType(it->Value(), vUndos);
-        if (vUndos[0].height < height) {
-            vKeysToDelete.push_back(key);
-        }
-    }
-    for (auto && key : vKeysToDelete) {
-        undos->Erase(key);
+        BettingUndoKey key;
+        std::vector<CBettingUndoDB> vUndos;
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
+        CBettingDB::BytesToDbType(it->ValueSlice(), vUndos);
+        if (vUndos.empty())
+            continue;
+        undoHeights->Write(UndoHeightKey{vUndos[0].height, key}, 0);
+        count++;
     }
+    return count;
 }
 
 bool CBettingsView::SaveFailedTx(const FailedTxKey& key) {
@@ -249,4 +614,515 @@ bool CBettingsView::EraseFailedTx(const FailedTxKey& key) {
     LOCK(cs_bettingdb);
 
     return failedBettingTxs->Erase(key);
-}
\ No newline at end of file
+}
+
+/**
+ * Load the dictionary of mappings, used for the global betting view.
+ */
+void CBettingsView::LoadMappingNames() {
+    LOCK(cs_bettingdb);
+
+    mappingNames = MakeUnique<CMappingNames>();
+    mappingNames->Load(*mappings);
+}
+
+/**
+ * Load the set of upcoming events, used for the global betting view after its mapping names.
+ */
+void CBettingsView::LoadUpcomingEvents(const uint64_t startTime) {
+    LOCK(cs_bettingdb);
+
+    assert(mappingNames);
+    upcomingEvents = MakeUnique<CUpcomingEvents>();
+    upcomingEvents->Load(*events, *eventStartTimes, startTime, *mappingNames);
+}
+
+bool CBettingsView::ReadMapping(const MappingKey& key, CMappingDB& mapping) {
+    LOCK(cs_bettingdb);
+
+    if (mappingNames)
+        return mappingNames->GetName(key, mapping.sName);
+    return mappings->Read(key, mapping);
+}
+
+/**
+ * Find id of the mapping by name, the lowest id is returned if several ids have the same name.
+ */
+bool CBettingsView::GetMappingId(const MappingType type, const std::string& name, uint32_t& id) {
+    LOCK(cs_bettingdb);
+
+    if (mappingNames)
+        return mappingNames->GetId(type, name, id);
+
+    auto it = mappings->NewIterator();
+    for (it->Seek(CBettingDB::DbTypeToBytes(MappingKey{type, 0})); it->Valid(); it->Next()) {
+        MappingKey key;
+        CMappingDB mapping;
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
+        if (key.nMType != type)
+            break;
+        CBettingDB::BytesToDbType(it->ValueSlice(), mapping);
+        if (mapping.sName == name) {
+            id = key.nId;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Write, update and erase peerless events together with their start time index.
+ */
+bool CBettingsView::WriteEvent(const EventKey& key, const CPeerlessExtendedEventDB& event) {
+    LOCK(cs_bettingdb);
+
+    if (!events->Write(key, event))
+        return false;
+    eventStartTimes->Write(EventStartKey{event.nStartTime, key.eventId}, 0);
+    return true;
+}
+
+bool CBettingsView::UpdateEvent(const EventKey& key, const CPeerlessExtendedEventDB& event) {
+    LOCK(cs_bettingdb);
+
+    CPeerlessExtendedEventDB prevEvent;
+    if (events->Read(key, prevEvent) && prevEvent.nStartTime != event.nStartTime) {
+        eventStartTimes->Erase(EventStartKey{prevEvent.nStartTime, key.eventId});
+        eventStartTimes->Write(EventStartKey{event.nStartTime, key.eventId}, 0);
+    }
+    return events->Update(key, event);
+}
+
+bool CBettingsView::EraseEvent(const EventKey& key) {
+    LOCK(cs_bettingdb);
+
+    CPeerlessExtendedEventDB event;
+    if (events->Read(key, event))
+        eventStartTimes->Erase(EventStartKey{event.nStartTime, key.eventId});
+    return events->Erase(key);
+}
+
+/**
+ * Collect peerless events starting at startTime or later with their mapping names, ordered by event id.
+ * The global view returns them from memory, cache views read them through the start time index.
+ */
+std::vector<CUpcomingEvent> CBettingsView::GetUpcomingEvents(const uint64_t startTime) {
+    LOCK(cs_bettingdb);
+
+    if (upcomingEvents)
+        return upcomingEvents->Get(startTime);
+
+    std::vector<CUpcomingEvent> vEvents;
+    auto it = eventStartTimes->NewIterator();
+    for (it->Seek(CBettingDB::DbTypeToBytes(EventStartKey{startTime, 0})); it->Valid(); it->Next()) {
+        EventStartKey key;
+        CPeerlessExtendedEventDB event;
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
+        if (!events->Read(EventKey{key.eventId}, event))
+            continue;
+        CUpcomingEvent upcoming(event);
+        CMappingDB sport, tournament, homeTeam, awayTeam;
+        upcoming.fNamesResolved = ReadMapping(MappingKey{sportMapping, event.nSport}, sport) &&
+                ReadMapping(MappingKey{tournamentMapping, event.nTournament}, tournament) &&
+                ReadMapping(MappingKey{teamMapping, event.nHomeTeam}, homeTeam) &&
+                ReadMapping(MappingKey{teamMapping, event.nAwayTeam}, awayTeam);
+        upcoming.sSport = sport.sName;
+        upcoming.sTournament = tournament.sName;
+        upcoming.sHomeTeam = homeTeam.sName;
+        upcoming.sAwayTeam = awayTeam.sName;
+        vEvents.emplace_back(upcoming);
+    }
+    std::sort(vEvents.begin(), vEvents.end(), [](const CUpcomingEvent& a, const CUpcomingEvent& b) {
+        return a.nEventId < b.nEventId;
+    });
+    return vEvents;
+}
+
+/**
+ * Build event start times index from events DB.
+ * @return number of the indexed events.
+ */
+uint32_t CBettingsView::ReindexEventStartTimes() {
+    LOCK(cs_bettingdb);
+
+    uint32_t count = 0;
+    auto it = events->NewIterator();
+    for (it->Seek(std::vector<unsigned char>{}); it->Valid(); it->Next()) {
+        EventKey key{0};
+        CPeerlessExtendedEventDB event;
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
+        CBettingDB::BytesToDbType(it->ValueSlice(), event);
+        eventStartTimes->Write(EventStartKey{event.nStartTime, key.eventId}, 0);
+        count++;
+    }
+    return count;
+}
+
+bool CBettingsView::SaveEventBets(const PeerlessBetKey& betKey, const std::vector<CPeerlessLegDB>& legs) {
+    LOCK(cs_bettingdb);
+
+    bool result = true;
+    for (const CPeerlessLegDB& leg : legs) {
+        result = eventBets->Write(EventBetKey{leg.nEventId, betKey}, 0) && result;
+    }
+    return result;
+}
+
+bool CBettingsView::EraseEventBets(const PeerlessBetKey& betKey, const std::vector<CPeerlessLegDB>& legs) {
+    LOCK(cs_bettingdb);
+
+    bool result = true;
+    for (const CPeerlessLegDB& leg : legs) {
+        result = eventBets->Erase(EventBetKey{leg.nEventId, betKey}) && result;
+    }
+    return result;
+}
+
+/**
+ * Collect keys of bets placed to the event starting from given height.
+ * Keys are returned in the same order as they are stored in the bets DB.
+ */
+std::vector<PeerlessBetKey> CBettingsView::GetEventBets(const uint32_t eventId, const uint32_t startHeight) {
+    LOCK(cs_bettingdb);
+
+    std::vector<PeerlessBetKey> vBetKeys;
+    auto it = eventBets->NewIterator();
+    for (it->Seek(CBettingDB::DbTypeToBytes(EventBetKey{eventId, PeerlessBetKey{startHeight, COutPoint()}})); it->Valid(); it->Next()) {
+        EventBetKey key;
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
+        if (key.eventId != eventId)
+            break;
+        vBetKeys.emplace_back(key.betKey);
+    }
+    return vBetKeys;
+}
+
+/**
+ * Build event bets index from bets DB.
+ * @return number of the indexed bets.
+ */
+uint32_t CBettingsView::ReindexEventBets() {
+    LOCK(cs_bettingdb);
+
+    uint32_t count = 0;
+    auto it = bets->NewIterator();
+    for (it->Seek(std::vector<unsigned char>{}); it->Valid(); it->Next()) {
+        PeerlessBetKey key;
+        CPeerlessBetDB bet;
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
+        CBettingDB::BytesToDbType(it->ValueSlice(), bet);
+        SaveEventBets(key, bet.legs);
+        count++;
+    }
+    return count;
+}
+
+bool CBettingsView::SavePlayerBet(const CBitcoinAddress& playerAddress, PlayerBetType betType, const PeerlessBetKey& betKey) {
+    LOCK(cs_bettingdb);
+
+    return playerBets->Write(PlayerBetKey{GetScriptForDestination(playerAddress.Get()), betType, betKey}, 0);
+}
+
+bool CBettingsView::ErasePlayerBet(const CBitcoinAddress& playerAddress, PlayerBetType betType, const PeerlessBetKey& betKey) {
+    LOCK(cs_bettingdb);
+
+    return playerBets->Erase(PlayerBetKey{GetScriptForDestination(playerAddress.Get()), betType, betKey});
+}
+
+/**
+ * Call fn for keys of the bets placed by any of the players, newest first,
+ * in the reverse order of the bets DB, until fn returns false.
+ */
+void CBettingsView::ForEachPlayerBet(const std::set<CScript>& playerScripts, PlayerBetType betType, std::function<bool(const PeerlessBetKey&)> fn) {
+    LOCK(cs_bettingdb);
+
+    struct PlayerCursor {
+        CScript playerScript;
+        std::unique_ptr<CStorageKVIterator> it;
+        PlayerBetKey key;
+        std::vector<unsigned char> vBetKey;
+    };
+    std::vector<PlayerCursor> vCursors;
+    // position a cursor at the newest bet of the player, returns false if the player has no bets
+    auto fillCursor = [&](PlayerCursor& cursor) {
+        if (!cursor.it->Valid()) return false;
+        CBettingDB::BytesToDbType(cursor.it->KeySlice(), cursor.key);
+        if (cursor.key.playerScript != cursor.playerScript || cursor.key.betType != betType) return false;
+        cursor.vBetKey = CBettingDB::DbTypeToBytes(cursor.key.betKey);
+        return true;
+    };
+    // max-heap of cursor indexes by bet key
+    auto cmp = [&vCursors](size_t a, size_t b) { return vCursors[a].vBetKey < vCursors[b].vBetKey; };
+    std::vector<size_t> vHeap;
+
+    // seek key with maximal bet key, which is stored as all zero bytes
+    PeerlessBetKey maxBetKey{std::numeric_limits<uint32_t>::max(), COutPoint{}};
+    for (const CScript& playerScript : playerScripts) {
+        std::vector<unsigned char> seekKey = CBettingDB::DbTypeToBytes(PlayerBetKey{playerScript, betType, maxBetKey});
+        std::fill(seekKey.end() - PlayerBetKey::betKeySize, seekKey.end(), 0);
+        PlayerCursor cursor;
+        cursor.playerScript = playerScript;
+        cursor.it = playerBets->NewIterator();
+        cursor.it->Seek(seekKey);
+        if (fillCursor(cursor)) {
+            vCursors.emplace_back(std::move(cursor));
+            vHeap.push_back(vCursors.size() - 1);
+        }
+    }
+    std::make_heap(vHeap.begin(), vHeap.end(), cmp);
+
+    while (!vHeap.empty()) {
+        std::pop_heap(vHeap.begin(), vHeap.end(), cmp);
+        PlayerCursor& cursor = vCursors[vHeap.back()];
+        if (!fn(cursor.key.betKey)) return;
+        cursor.it->Next();
+        if (fillCursor(cursor)) {
+            std::push_heap(vHeap.begin(), vHeap.end(), cmp);
+        }
+        else {
+            vHeap.pop_back();
+        }
+    }
+}
+
+/**
+ * Build player bets index from bets DBs.
+ * @return number of the indexed bets.
+ */
+uint32_t CBettingsView::ReindexPlayerBets() {
+    LOCK(cs_bettingdb);
+
+    uint32_t count = 0;
+    auto it = bets->NewIterator();
+    for (it->Seek(std::vector<unsigned char>{}); it->Valid(); it->Next()) {
+        PeerlessBetKey key;
+        CPeerlessBetDB bet;
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
+        CBettingDB::BytesToDbType(it->ValueSlice(), bet);
+        SavePlayerBet(bet.playerAddress, playerPeerlessBet, key);
+        count++;
+    }
+    auto qgIt = quickGamesBets->NewIterator();
+    for (qgIt->Seek(std::vector<unsigned char>{}); qgIt->Valid(); qgIt->Next()) {
+        QuickGamesBetKey key;
+        CQuickGamesBetDB qgBet;
+        CBettingDB::BytesToDbType(qgIt->KeySlice(), key);
+        CBettingDB::BytesToDbType(qgIt->ValueSlice(), qgBet);
+        SavePlayerBet(qgBet.playerAddress, playerQuickGamesBet, key);
+        count++;
+    }
+    return count;
+}
+
+bool CBettingsView::SaveBettingTx(const uint256& txHash, const uint32_t height) {
+    LOCK(cs_bettingdb);
+
+    return bettingTxs->Write(BettingTxKey{txHash}, height);
+}
+
+bool CBettingsView::EraseBettingTx(const uint256& txHash) {
+    LOCK(cs_bettingdb);
+
+    return bettingTxs->Erase(BettingTxKey{txHash});
+}
+
+/**
+ * Get the block height of a bet or payout transaction,
+ * returns false if the transaction has no bets or payouts.
+ */
+bool CBettingsView::GetBettingTxHeight(const uint256& txHash, uint32_t& height) {
+    LOCK(cs_bettingdb);
+
+    return bettingTxs->Read(BettingTxKey{txHash}, height);
+}
+
+/**
+ * Build betting txs index from bets and payouts info DBs.
+ * @return number of the indexed bets and payouts.
+ */
+uint32_t CBettingsView::ReindexBettingTxs() {
+    LOCK(cs_bettingdb);
+
+    uint32_t count = 0;
+    // keys of all the indexed DBs start with height and outpoint
+    for (CBettingDB* db : {bets.get(), quickGamesBets.get(), payoutsInfo.get()}) {
+        auto it = db->NewIterator();
+        for (it->Seek(std::vector<unsigned char>{}); it->Valid(); it->Next()) {
+            PeerlessBetKey key;
+            CBettingDB::BytesToDbType(it->KeySlice(), key);
+            SaveBettingTx(key.outPoint.hash, key.blockHeight);
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * Set the height from which oracle results are recorded by block,
+ * blocks connected before it by older versions have no results records.
+ */
+void CBettingsView::InitBlockResults() {
+    LOCK(cs_bettingdb);
+
+    // betting txs are processed only after V2 start height
+    uint32_t startHeight = std::max(GetLastHeight(), (uint32_t)Params().WagerrProtocolV2StartHeight()) + 1;
+    if (!blockResults->Exists(std::string("StartHeight"))) {
+        blockResults->Write(std::string("StartHeight"), startHeight);
+    }
+}
+
+bool CBettingsView::SaveBlockResults(const uint32_t height, const std::vector<CPeerlessResultDB>& vPeerlessResults, const std::vector<CChainGamesResultDB>& vChainGamesResults) {
+    LOCK(cs_bettingdb);
+
+    CBlockResultsDB results;
+    bool fExists = blockResults->Read(BlockResultsKey{height}, results);
+    results.vPeerlessResults.insert(results.vPeerlessResults.end(), vPeerlessResults.begin(), vPeerlessResults.end());
+    results.vChainGamesResults.insert(results.vChainGamesResults.end(), vChainGamesResults.begin(), vChainGamesResults.end());
+    if (fExists)
+        return blockResults->Update(BlockResultsKey{height}, results);
+    return blockResults->Write(BlockResultsKey{height}, results);
+}
+
+bool CBettingsView::EraseBlockResults(const uint32_t height) {
+    LOCK(cs_bettingdb);
+
+    if (!blockResults->Exists(BlockResultsKey{height}))
+        return true;
+    return blockResults->Erase(BlockResultsKey{height});
+}
+
+/**
+ * Get results posted in the block.
+ * @return false if results of the block weren't recorded and the block should be read from disk.
+ */
+bool CBettingsView::GetBlockResults(const uint32_t height, CBlockResultsDB& results) {
+    LOCK(cs_bettingdb);
+
+    if (blockResults->Read(BlockResultsKey{height}, results))
+        return true;
+
+    // only blocks up to the last connected one are known to be recorded
+    uint32_t startHeight;
+    if (blockResults->Read(std::string("StartHeight"), startHeight) && height >= startHeight && height <= GetLastHeight()) {
+        // block was connected without results
+        results = CBlockResultsDB{};
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Set the height from which completed bets are recorded by block,
+ * payouts of blocks connected before it by older versions have no records.
+ */
+void CBettingsView::InitCompletedBets() {
+    LOCK(cs_bettingdb);
+
+    uint32_t startHeight = std::max(GetLastHeight(), (uint32_t)Params().WagerrProtocolV2StartHeight()) + 1;
+    if (!completedBets->Exists(std::string("StartHeight"))) {
+        completedBets->Write(std::string("StartHeight"), startHeight);
+    }
+}
+
+bool CBettingsView::SaveCompletedBet(const uint32_t height, const PeerlessBetKey& betKey) {
+    LOCK(cs_bettingdb);
+
+    CompletedBetKey key{height, betKey};
+    if (completedBets->Exists(key))
+        return true;
+    return completedBets->Write(key, 0);
+}
+
+/**
+ * Get keys of the bets completed by payouts of the block.
+ * @return false if the block was connected without recording of completed bets.
+ */
+bool CBettingsView::GetCompletedBets(const uint32_t height, std::vector<PeerlessBetKey>& vBetKeys) {
+    LOCK(cs_bettingdb);
+
+    uint32_t startHeight;
+    if (!completedBets->Read(std::string("StartHeight"), startHeight) || height < startHeight)
+        return false;
+
+    // serialized "StartHeight" key is ordered after keys of all heights
+    static std::vector<unsigned char> startHeightKey = CBettingDB::DbTypeToBytes(std::string("StartHeight"));
+    vBetKeys.clear();
+    auto it = completedBets->NewIterator();
+    for (it->Seek(CBettingDB::DbTypeToBytes(CompletedBetKey{height, PeerlessBetKey{}})); it->Valid(); it->Next()) {
+        if (it->KeySlice() == startHeightKey)
+            break;
+        CompletedBetKey key;
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
+        if (key.height != height)
+            break;
+        vBetKeys.emplace_back(key.betKey);
+    }
+    return true;
+}
+
+bool CBettingsView::EraseCompletedBets(const uint32_t height) {
+    LOCK(cs_bettingdb);
+
+    std::vector<PeerlessBetKey> vBetKeys;
+    if (!GetCompletedBets(height, vBetKeys))
+        return true;
+    bool result = true;
+    for (const PeerlessBetKey& betKey : vBetKeys) {
+        result = completedBets->Erase(CompletedBetKey{height, betKey}) && result;
+    }
+    return result;
+}
+
+void CBettingsView::PruneOlderCompletedBets(const uint32_t height) {
+    LOCK(cs_bettingdb);
+
+    static std::vector<unsigned char> startHeightKey = CBettingDB::DbTypeToBytes(std::string("StartHeight"));
+    std::vector<CompletedBetKey> vKeysToDelete;
+    auto it = completedBets->NewIterator();
+    for (it->Seek(std::vector<unsigned char>{}); it->Valid(); it->Next()) {
+        if (it->KeySlice() == startHeightKey)
+            break;
+        CompletedBetKey key;
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
+        if (key.height >= height)
+            break;
+        vKeysToDelete.push_back(key);
+    }
+    for (auto && key : vKeysToDelete) {
+        completedBets->Erase(key);
+    }
+}
+
+void CBettingsView::InitParlayLegs() {
+    LOCK(cs_bettingdb);
+
+    // legs of parlays placed since this height are resolved by payouts of the blocks,
+    // bets to resulted events weren't checked at testnet blocks with skipped validation
+    uint32_t startHeight = std::max({GetLastHeight() + 1, (uint32_t)Params().WagerrProtocolV3StartHeight(), (uint32_t)Params().SkipBetValidationEnd()});
+    if (!parlayLegs->Exists(std::string("StartHeight"))) {
+        parlayLegs->Write(std::string("StartHeight"), startHeight);
+    }
+}
+
+/**
+ * Get height since which the legs of placed parlay bets are kept resolved.
+ * @return max height if resolution of parlay legs isn't initialized.
+ */
+uint32_t CBettingsView::GetParlayLegsStartHeight() {
+    LOCK(cs_bettingdb);
+
+    uint32_t startHeight;
+    if (!parlayLegs->Read(std::string("StartHeight"), startHeight))
+        return std::numeric_limits<uint32_t>::max();
+    return startHeight;
+}
+
+bool CBettingsView::SaveParlayLegs(const ParlayLegsKey& key, const CParlayLegsDB& legs) {
+    LOCK(cs_bettingdb);
+
+    if (legs.nResolvedLegs == 0)
+        return !parlayLegs->Exists(key) || parlayLegs->Erase(key);
+    if (parlayLegs->Exists(key))
+        return parlayLegs->Update(key, legs);
+    return parlayLegs->Write(key, legs);
+}
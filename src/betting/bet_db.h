@@ -9,7 +9,12 @@
 #include <serialize.h>
 #include <betting/bet_common.h>
 #include <betting/bet_tx.h>
+#include <compat/endian.h>
 #include <flushablestorage/flushablestorage.h>
+#include <functional>
+#include <map>
+#include <set>
+#include <boost/unordered_map.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/variant.hpp>
 #include <boost/exception/to_string.hpp>
@@ -314,6 +319,203 @@ typedef struct PeerlessBetKey {
     }
 } PeerlessBetKey;
 
+// EventStartKey - secondary index of peerless events by start time
+typedef struct EventStartKey {
+    uint64_t startTime;
+    uint32_t eventId;
+
+    explicit EventStartKey() : startTime(0), eventId(0) { }
+    explicit EventStartKey(uint64_t time, uint32_t id) : startTime(time), eventId(id) { }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp (Stream& s, Operation ser_action, int nType, int nVersion) {
+        uint64_t be_time;
+        uint32_t be_val;
+        if (ser_action.ForRead()) {
+            READWRITE(be_time);
+            startTime = be64toh(be_time);
+            READWRITE(be_val);
+            eventId = ntohl(be_val);
+        }
+        else {
+            be_time = htobe64(startTime);
+            READWRITE(be_time);
+            be_val = htonl(eventId);
+            READWRITE(be_val);
+        }
+    }
+} EventStartKey;
+
+// EventBetKey - secondary index of peerless bets by event id
+// (parlay bets are indexed under each leg's event)
+typedef struct EventBetKey {
+    uint32_t eventId;
+    PeerlessBetKey betKey;
+
+    explicit EventBetKey() : eventId(0), betKey(PeerlessBetKey()) { }
+    explicit EventBetKey(uint32_t id, const PeerlessBetKey& key) : eventId(id), betKey(key) { }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp (Stream& s, Operation ser_action, int nType, int nVersion) {
+        uint32_t be_val;
+        if (ser_action.ForRead()) {
+            READWRITE(be_val);
+            eventId = ntohl(be_val);
+        }
+        else {
+            be_val = htonl(eventId);
+            READWRITE(be_val);
+        }
+        READWRITE(betKey);
+    }
+} EventBetKey;
+
+typedef enum PlayerBetType {
+    playerPeerlessBet    = 0x01,
+    playerQuickGamesBet  = 0x02,
+} PlayerBetType;
+
+// PlayerBetKey - secondary index of bets by player script and bet type.
+// The bet key is stored with inverted bytes, so iterating forward over a player
+// returns the bets in the reverse order of the bets DB (newest first).
+typedef struct PlayerBetKey {
+    static constexpr size_t betKeySize = 40; // serialized PeerlessBetKey: height + outpoint
+
+    CScript playerScript;
+    PlayerBetType betType;
+    PeerlessBetKey betKey;
+
+    explicit PlayerBetKey() : playerScript(CScript()), betType(playerPeerlessBet), betKey(PeerlessBetKey()) { }
+    explicit PlayerBetKey(const CScript& script, PlayerBetType type, const PeerlessBetKey& key) : playerScript(script), betType(type), betKey(key) { }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp (Stream& s, Operation ser_action, int nType, int nVersion) {
+        READWRITE(playerScript);
+        uint8_t type;
+        unsigned char vchBetKey[betKeySize];
+        if (ser_action.ForRead()) {
+            READWRITE(type);
+            betType = (PlayerBetType) type;
+            READWRITE(FLATDATA(vchBetKey));
+            for (size_t i = 0; i < betKeySize; i++) vchBetKey[i] = ~vchBetKey[i];
+            CDataStream ssBetKey((const char*)vchBetKey, (const char*)vchBetKey + betKeySize, nType, nVersion);
+            ssBetKey >> betKey;
+        }
+        else {
+            type = (uint8_t) betType;
+            READWRITE(type);
+            CDataStream ssBetKey(nType, nVersion);
+            ssBetKey << betKey;
+            assert(ssBetKey.size() == betKeySize);
+            for (size_t i = 0; i < betKeySize; i++) vchBetKey[i] = ~(unsigned char)ssBetKey[i];
+            READWRITE(FLATDATA(vchBetKey));
+        }
+    }
+} PlayerBetKey;
+
+// BettingTxKey - secondary index of bet and payout transactions by txid,
+// maps the txid to the height used in the bets and payouts info keys
+typedef struct BettingTxKey {
+    uint256 txHash;
+
+    explicit BettingTxKey() : txHash(uint256()) { }
+    explicit BettingTxKey(const uint256& hash) : txHash(hash) { }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp (Stream& s, Operation ser_action, int nType, int nVersion) {
+        READWRITE(txHash);
+    }
+} BettingTxKey;
+
+// CompletedBetKey - peerless bets completed by payouts of the block at height
+typedef struct CompletedBetKey {
+    uint32_t height;
+    PeerlessBetKey betKey;
+
+    explicit CompletedBetKey() : height(0), betKey(PeerlessBetKey()) { }
+    explicit CompletedBetKey(uint32_t h, const PeerlessBetKey& key) : height(h), betKey(key) { }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp (Stream& s, Operation ser_action, int nType, int nVersion) {
+        uint32_t be_val;
+        if (ser_action.ForRead()) {
+            READWRITE(be_val);
+            height = ntohl(be_val);
+        }
+        else {
+            be_val = htonl(height);
+            READWRITE(be_val);
+        }
+        READWRITE(betKey);
+    }
+} CompletedBetKey;
+
+using ParlayLegsKey = PeerlessBetKey;
+
+// leg of parlay bet, resolved by the result of its event
+class CParlayLegDB
+{
+public:
+    // height of the block with payouts which resolved the leg, 0 if unresolved
+    uint32_t nResolveHeight = 0;
+    uint32_t nOnchainOdds = 0;
+    uint32_t nEffectiveOdds = 0;
+
+    explicit CParlayLegDB() { }
+
+    bool IsResolved() const { return nResolveHeight != 0; }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp (Stream& s, Operation ser_action, int nType, int nVersion) {
+        READWRITE(nResolveHeight);
+        READWRITE(nOnchainOdds);
+        READWRITE(nEffectiveOdds);
+    }
+};
+
+// resolution state of parlay bet legs, in order of the bet legs
+class CParlayLegsDB
+{
+public:
+    std::vector<CParlayLegDB> vLegs;
+    uint32_t nResolvedLegs = 0;
+
+    explicit CParlayLegsDB() { }
+    explicit CParlayLegsDB(size_t nLegs) : vLegs(nLegs) { }
+
+    void ResolveLeg(size_t idx, uint32_t height, const std::pair<uint32_t, uint32_t>& odds) {
+        if (!vLegs[idx].IsResolved()) nResolvedLegs++;
+        vLegs[idx].nResolveHeight = height;
+        vLegs[idx].nOnchainOdds = odds.first;
+        vLegs[idx].nEffectiveOdds = odds.second;
+    }
+
+    void UnresolveLeg(size_t idx) {
+        if (vLegs[idx].IsResolved()) nResolvedLegs--;
+        vLegs[idx] = CParlayLegDB();
+    }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp (Stream& s, Operation ser_action, int nType, int nVersion) {
+        READWRITE(vLegs);
+        READWRITE(nResolvedLegs);
+    }
+};
+
 class CPeerlessLegDB
 {
 public:
@@ -503,6 +705,53 @@ public:
     }
 };
 
+/*
+ * Block results database structures
+ */
+
+// HeightKey
+typedef struct HeightKey {
+    uint32_t height;
+
+    explicit HeightKey() : height(0) { }
+    explicit HeightKey(uint32_t h) : height(h) { }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp (Stream& s, Operation ser_action, int nType, int nVersion) {
+        uint32_t be_val;
+        if (ser_action.ForRead()) {
+            READWRITE(be_val);
+            height = ntohl(be_val);
+        }
+        else {
+            be_val = htonl(height);
+            READWRITE(be_val);
+        }
+    }
+} HeightKey;
+
+using BlockResultsKey = HeightKey;
+
+// results posted by oracles in the block, in order of appearance
+class CBlockResultsDB
+{
+public:
+    std::vector<CPeerlessResultDB> vPeerlessResults;
+    std::vector<CChainGamesResultDB> vChainGamesResults;
+
+    explicit CBlockResultsDB() { }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp (Stream& s, Operation ser_action, int nType, int nVersion) {
+        READWRITE(vPeerlessResults);
+        READWRITE(vChainGamesResults);
+    }
+};
+
 /*
  * Quick games database structures
  */
@@ -644,6 +893,31 @@ private:
     BettingUndoVariant undoVariant;
 };
 
+// UndoHeightKey - secondary index of undos by height
+typedef struct UndoHeightKey {
+    uint32_t height;
+    BettingUndoKey undoKey;
+
+    explicit UndoHeightKey() : height(0), undoKey(BettingUndoKey()) { }
+    explicit UndoHeightKey(uint32_t h, const BettingUndoKey& key) : height(h), undoKey(key) { }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp (Stream& s, Operation ser_action, int nType, int nVersion) {
+        uint32_t be_val;
+        if (ser_action.ForRead()) {
+            READWRITE(be_val);
+            height = ntohl(be_val);
+        }
+        else {
+            be_val = htonl(height);
+            READWRITE(be_val);
+        }
+        READWRITE(undoKey);
+    }
+} UndoHeightKey;
+
 /*
  * Betting payout info database structures
  */
@@ -774,22 +1048,36 @@ public:
 
     unsigned int GetCacheSizeBytesToWrite();
 
+    // raw changes of the cache layer, used for replaying of memoized calculations
+    const MapKV& GetCacheChanges();
+
+    // move the raw changes out of the cache layer, leaving it empty
+    MapKV TakeCacheChanges();
+
+    bool ApplyCacheChanges(const MapKV& changes);
+
     static size_t dbWrapperCacheSize();
 
     static std::string MakeDbPath(const char* name);
 
+    // erase all the entries, used for rebuilding of indexes
+    void Clear();
+
     template<typename T>
     static std::vector<unsigned char> DbTypeToBytes(const T& value)
     {
-        CDataStream stream(SER_DISK, CLIENT_VERSION);
+        std::vector<unsigned char> bytes;
+        bytes.reserve(::GetSerializeSize(value, SER_DISK, CLIENT_VERSION));
+        CStorageKVWriter stream(bytes, SER_DISK, CLIENT_VERSION);
         stream << value;
-        return std::vector<unsigned char>(stream.begin(), stream.end());
+        return bytes;
     }
 
+    // decodes in place, pass iterator KeySlice()/ValueSlice() to avoid copying the entry
     template<typename T>
-    static void BytesToDbType(const std::vector<unsigned char>& bytes, T& value)
+    static void BytesToDbType(const CStorageKVSlice& bytes, T& value)
     {
-        CDataStream stream(bytes, SER_DISK, CLIENT_VERSION);
+        CStorageKVSliceReader stream(bytes, SER_DISK, CLIENT_VERSION);
         stream >> value;
         assert(stream.size() == 0);
     }
@@ -797,6 +1085,69 @@ public:
 
 using FailedTxKey = BettingUndoKey;
 
+/**
+ * In-memory dictionary of mapping names by id and mapping ids by name,
+ * loaded from the mappings DB and updated with the changes flushed to it.
+ */
+class CMappingNames
+{
+public:
+    void Load(CBettingDB& mappings);
+
+    void ApplyChanges(const MapKV& changes);
+
+    bool GetName(const MappingKey& key, std::string& name) const;
+
+    bool GetId(const MappingType type, const std::string& name, uint32_t& id) const;
+
+private:
+    void Insert(const MappingKey& key, const std::string& name);
+    void Remove(const MappingKey& key);
+
+    boost::unordered_map<std::pair<uint32_t, uint32_t>, std::string> mapNames;
+    // several ids can have the same name, the lowest id is used as in mappings DB order
+    boost::unordered_map<std::pair<uint32_t, std::string>, std::set<uint32_t>> mapIds;
+};
+
+/** Upcoming peerless event with the names of its sport, tournament and teams */
+class CUpcomingEvent : public CPeerlessExtendedEventDB
+{
+public:
+    std::string sSport;
+    std::string sTournament;
+    std::string sHomeTeam;
+    std::string sAwayTeam;
+    // false if some of the mappings is missing
+    bool fNamesResolved = false;
+
+    CUpcomingEvent() {}
+    explicit CUpcomingEvent(const CPeerlessExtendedEventDB& event) : CPeerlessExtendedEventDB(event) {}
+};
+
+/**
+ * In-memory set of peerless events which are not started yet, with the names of their mappings.
+ * Loaded from the events DB and updated with the changes flushed to the events and mappings DBs.
+ */
+class CUpcomingEvents
+{
+public:
+    void Load(CBettingDB& events, CBettingDB& eventStartTimes, const uint64_t startTime, const CMappingNames& names);
+
+    void ApplyChanges(const MapKV& changes, const CMappingNames& names);
+
+    void ResolveNames(const CMappingNames& names);
+
+    std::vector<CUpcomingEvent> Get(const uint64_t startTime);
+
+private:
+    void Insert(const CPeerlessExtendedEventDB& event, const CMappingNames& names);
+
+    // ordered by event id
+    std::map<uint32_t, CUpcomingEvent> mapEvents;
+    // events started before this time are dropped
+    uint64_t nStartTime = 0;
+};
+
 /** Container for several db objects */
 class CBettingsView
 {
@@ -808,10 +1159,25 @@ public:
     std::unique_ptr<CStorageKV> resultsStorage;
     std::unique_ptr<CBettingDB> events; // "events"
     std::unique_ptr<CStorageKV> eventsStorage;
+    // secondary index of peerless events by start time, used for listing of upcoming events
+    std::unique_ptr<CBettingDB> eventStartTimes; // "eventstarttimes"
+    std::unique_ptr<CStorageKV> eventStartTimesStorage;
     std::unique_ptr<CBettingDB> bets; // "bets"
     std::unique_ptr<CStorageKV> betsStorage;
+    // secondary index of bets by event id, avoids full bets scan on payouts
+    std::unique_ptr<CBettingDB> eventBets; // "eventbets"
+    std::unique_ptr<CStorageKV> eventBetsStorage;
+    // secondary index of peerless and quick games bets by player script
+    std::unique_ptr<CBettingDB> playerBets; // "playerbets"
+    std::unique_ptr<CStorageKV> playerBetsStorage;
+    // secondary index of bet and payout transactions by txid, value is the tx block height
+    std::unique_ptr<CBettingDB> bettingTxs; // "bettingtxs"
+    std::unique_ptr<CStorageKV> bettingTxsStorage;
     std::unique_ptr<CBettingDB> undos; // "undos"
     std::unique_ptr<CStorageKV> undosStorage;
+    // secondary index of undos by height, used for pruning of old undos
+    std::unique_ptr<CBettingDB> undoHeights; // "undoheights"
+    std::unique_ptr<CStorageKV> undoHeightsStorage;
     std::unique_ptr<CBettingDB> payoutsInfo; // "payoutsinfo"
     std::unique_ptr<CStorageKV> payoutsInfoStorage;
     std::unique_ptr<CBettingDB> quickGamesBets; // "quickgamesbets"
@@ -822,11 +1188,26 @@ public:
     std::unique_ptr<CStorageKV> chainGamesLottoBetsStorage;
     std::unique_ptr<CBettingDB> chainGamesLottoResults; // "cglottoresults"
     std::unique_ptr<CStorageKV> chainGamesLottoResultsStorage;
+    // results posted by oracles, grouped by block height
+    std::unique_ptr<CBettingDB> blockResults; // "blockresults"
+    std::unique_ptr<CStorageKV> blockResultsStorage;
+    // peerless bets completed by payouts of the block, used for undo of payouts
+    std::unique_ptr<CBettingDB> completedBets; // "completedbets"
+    std::unique_ptr<CStorageKV> completedBetsStorage;
+    // resolution state of parlay bet legs, updated by payouts of the blocks
+    std::unique_ptr<CBettingDB> parlayLegs; // "parlaylegs"
+    std::unique_ptr<CStorageKV> parlayLegsStorage;
     // save failed tx ids which contain in chain, but not affect on
     // it needed to avoid undo issues, when we try undo not affected tx
     std::unique_ptr<CBettingDB> failedBettingTxs; // "failedtxs"
     std::unique_ptr<CStorageKV> failedBettingTxsStorage;
 
+    // dictionary of mappings, kept by the global betting view only
+    std::unique_ptr<CMappingNames> mappingNames;
+    // upcoming events with mapping names, kept by the global betting view only
+    std::unique_ptr<CUpcomingEvents> upcomingEvents;
+    CBettingsView* parentView = nullptr;
+
     // default constructor
     explicit CBettingsView() { }
 
@@ -839,10 +1220,21 @@ public:
 
     unsigned int GetCacheSizeBytesToWrite();
 
-    void SetLastHeight(uint32_t height);
+    // all the stores of the view, in the order of declaration
+    std::vector<CBettingDB*> GetStores();
+
+    std::vector<MapKV> TakeCacheChanges();
+
+    bool ApplyCacheChanges(const std::vector<MapKV>& changes);
+
+    void SetLastHeight(uint32_t height, const uint256& hashBlock);
 
     uint32_t GetLastHeight();
 
+    bool IndexesSynced(const uint256& hashLastBlock);
+
+    void RebuildIndexes(const uint256& hashLastBlock);
+
     bool SaveBettingUndo(const BettingUndoKey& key, std::vector<CBettingUndoDB> vUndos);
 
     bool EraseBettingUndo(const BettingUndoKey& key);
@@ -858,6 +1250,79 @@ public:
     bool ExistFailedTx(const FailedTxKey& key);
 
     bool EraseFailedTx(const FailedTxKey& key);
+
+    void LoadMappingNames();
+
+    void LoadUpcomingEvents(const uint64_t startTime);
+
+    bool ReadMapping(const MappingKey& key, CMappingDB& mapping);
+
+    bool GetMappingId(const MappingType type, const std::string& name, uint32_t& id);
+
+    bool WriteEvent(const EventKey& key, const CPeerlessExtendedEventDB& event);
+
+    bool UpdateEvent(const EventKey& key, const CPeerlessExtendedEventDB& event);
+
+    bool EraseEvent(const EventKey& key);
+
+    std::vector<CUpcomingEvent> GetUpcomingEvents(const uint64_t startTime);
+
+    bool SaveEventBets(const PeerlessBetKey& betKey, const std::vector<CPeerlessLegDB>& legs);
+
+    bool EraseEventBets(const PeerlessBetKey& betKey, const std::vector<CPeerlessLegDB>& legs);
+
+    std::vector<PeerlessBetKey> GetEventBets(const uint32_t eventId, const uint32_t startHeight);
+
+    bool SavePlayerBet(const CBitcoinAddress& playerAddress, PlayerBetType betType, const PeerlessBetKey& betKey);
+
+    bool ErasePlayerBet(const CBitcoinAddress& playerAddress, PlayerBetType betType, const PeerlessBetKey& betKey);
+
+    void ForEachPlayerBet(const std::set<CScript>& playerScripts, PlayerBetType betType, std::function<bool(const PeerlessBetKey&)> fn);
+
+    bool SaveBettingTx(const uint256& txHash, const uint32_t height);
+
+    bool EraseBettingTx(const uint256& txHash);
+
+    bool GetBettingTxHeight(const uint256& txHash, uint32_t& height);
+
+    void InitBlockResults();
+
+    bool SaveBlockResults(const uint32_t height, const std::vector<CPeerlessResultDB>& vPeerlessResults, const std::vector<CChainGamesResultDB>& vChainGamesResults);
+
+    bool EraseBlockResults(const uint32_t height);
+
+    bool GetBlockResults(const uint32_t height, CBlockResultsDB& results);
+
+    void InitCompletedBets();
+
+    bool SaveCompletedBet(const uint32_t height, const PeerlessBetKey& betKey);
+
+    bool GetCompletedBets(const uint32_t height, std::vector<PeerlessBetKey>& vBetKeys);
+
+    bool EraseCompletedBets(const uint32_t height);
+
+    void PruneOlderCompletedBets(const uint32_t height);
+
+    void InitParlayLegs();
+
+    uint32_t GetParlayLegsStartHeight();
+
+    bool SaveParlayLegs(const ParlayLegsKey& key, const CParlayLegsDB& legs);
+
+private:
+    void SetIndexedBlock(const uint256& hashBlock);
+
+    void RebuildIndex(CBettingDB& index, const char* desc, std::function<uint32_t()> fnBuild);
+
+    uint32_t ReindexEventStartTimes();
+
+    uint32_t ReindexEventBets();
+
+    uint32_t ReindexPlayerBets();
+
+    uint32_t ReindexBettingTxs();
+
+    uint32_t ReindexUndoHeights();
 };
 
 #endif
\ No newline at end of file
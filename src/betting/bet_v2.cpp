@@ -9,6 +9,112 @@
 #include <amount.h>
 #include <main.h>
 
+#include <map>
+#include <memory>
+
+/**
+ * Betting transactions of a block in block order, with the OP RETURN outputs
+ * and the inputs data which are used by the V2 payout scans.
+ */
+class CBettingBlockV2
+{
+public:
+    class CBettingOut
+    {
+    public:
+        uint32_t nOut;
+        CAmount nValue;
+        std::shared_ptr<CBettingTx> bettingTx;
+    };
+
+    class CBettingTxV2
+    {
+    public:
+        uint256 txHash;
+        COutPoint prevout;   // first input of the tx, spent by the player
+        bool validOracleTx;
+        std::vector<CBettingOut> vOuts;
+    };
+
+    uint256 blockHash;
+    time_t nTime = 0;
+    std::vector<CBettingTxV2> vtx;
+};
+
+typedef std::shared_ptr<const CBettingBlockV2> CBettingBlockV2Ref;
+
+/**
+ * The V2 payout scans look back over the same blocks for every result, so while syncing
+ * keep the parsed blocks of the look back window and slide it with the chain tip.
+ */
+static CCriticalSection cs_bettingBlocksV2;
+static std::map<int, CBettingBlockV2Ref> mapBettingBlocksV2;
+
+static CBettingBlockV2Ref ParseBettingBlockV2(const CBlockIndex* pindex)
+{
+    auto bettingBlock = std::make_shared<CBettingBlockV2>();
+    CBlock block;
+    ReadBlockFromDisk(block, pindex);
+    bettingBlock->blockHash = pindex->GetBlockHash();
+    bettingBlock->nTime = block.nTime;
+
+    for (const CTransaction& tx : block.vtx) {
+        CBettingBlockV2::CBettingTxV2 bettingTx;
+        for (unsigned int i = 0; i < tx.vout.size(); i++) {
+            auto bettingOut = ParseBettingTx(tx.vout[i]);
+
+            if (bettingOut == nullptr) continue;
+
+            bettingTx.vOuts.emplace_back(CBettingBlockV2::CBettingOut{i, tx.vout[i].nValue, std::move(bettingOut)});
+        }
+
+        if (bettingTx.vOuts.empty()) continue;
+
+        bettingTx.txHash = tx.GetHash();
+        bettingTx.prevout = tx.vin[0].prevout;
+        bettingTx.validOracleTx = IsValidOracleTx(tx.vin[0], pindex->nHeight);
+        bettingBlock->vtx.emplace_back(std::move(bettingTx));
+    }
+    return bettingBlock;
+}
+
+/**
+ * Move the window of parsed blocks to the blocks scanned when connecting the block
+ * after nLastBlockHeight, the window is only kept during initial block download
+ * (including -reindex). Returns whether the window should be used.
+ */
+static bool SlideBettingBlocksV2(const int nLastBlockHeight)
+{
+    LOCK(cs_bettingBlocksV2);
+
+    // scans of historical blocks (e.g. from RPC) read the blocks once per request
+    if (nLastBlockHeight != chainActive.Height())
+        return false;
+
+    if (!IsInitialBlockDownload()) {
+        mapBettingBlocksV2.clear();
+        return false;
+    }
+
+    const int nStartHeight = nLastBlockHeight - std::max(Params().BetBlocksIndexTimespanV2(), 14400);
+    mapBettingBlocksV2.erase(mapBettingBlocksV2.begin(), mapBettingBlocksV2.lower_bound(nStartHeight));
+    return true;
+}
+
+static CBettingBlockV2Ref GetBettingBlockV2(const CBlockIndex* pindex, const bool fUseWindow)
+{
+    if (!fUseWindow)
+        return ParseBettingBlockV2(pindex);
+
+    LOCK(cs_bettingBlocksV2);
+
+    CBettingBlockV2Ref& bettingBlock = mapBettingBlocksV2[pindex->nHeight];
+    // reparse the height when the chain has been reorganized
+    if (!bettingBlock || bettingBlock->blockHash != pindex->GetBlockHash())
+        bettingBlock = ParseBettingBlockV2(pindex);
+    return bettingBlock;
+}
+
 /**
  * Takes a payout vector and aggregates the total WGR that is required to pay out all bets.
  * We also calculate and add the OMNO and dev fund rewards.
@@ -86,12 +192,14 @@ int64_t GetCGBlockPayoutsV2(std::vector<CBetOut>& vexpectedCGPayouts, CAmount& n
  *
  * @return payout vector.
  */
-void GetBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vExpectedPayouts, std::vector<CPayoutInfoDB>& vPayoutsInfo)
+void GetBetPayoutsV2(CBettingsView &bettingsViewCache, const int nNewBlockHeight, std::vector<CBetOut>& vExpectedPayouts, std::vector<CPayoutInfoDB>& vPayoutsInfo)
 {
     int nLastBlockHeight = chainActive.Height();
 
     // Get all the results posted in the latest block.
-    std::vector<CPeerlessResultDB> results = GetEventResults(nNewBlockHeight - 1);
+    std::vector<CPeerlessResultDB> results = GetEventResults(bettingsViewCache, nNewBlockHeight - 1);
+
+    const bool fUseWindow = SlideBettingBlocksV2(nLastBlockHeight);
 
     // Traverse the blockchain for an event to match a result and all the bets on a result.
     for (const auto& result : results) {
@@ -143,29 +251,24 @@ void GetBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vExpectedP
 
         // Traverse the block chain to find events and bets.
         while (BlocksIndex) {
-            CBlock block;
-            ReadBlockFromDisk(block, BlocksIndex);
-            time_t transactionTime = block.nTime;
+            CBettingBlockV2Ref block = GetBettingBlockV2(BlocksIndex, fUseWindow);
+            time_t transactionTime = block->nTime;
             uint32_t nHeight = BlocksIndex->nHeight;
 
-            for (CTransaction &tx : block.vtx) {
+            for (const CBettingBlockV2::CBettingTxV2 &tx : block->vtx) {
                 // Ensure TX has it been posted by Oracle wallet.
-                const CTxIn &txin = tx.vin[0];
-                bool validOracleTx = IsValidOracleTx(txin, nHeight);
-                // Check all TX vouts for an OP RETURN.
-                for (unsigned int i = 0; i < tx.vout.size(); i++) {
+                bool validOracleTx = tx.validOracleTx;
+                // Check all TX OP RETURN vouts.
+                for (const CBettingBlockV2::CBettingOut &txout : tx.vOuts) {
 
-                    const CTxOut &txout = tx.vout[i];
                     CAmount betAmount = txout.nValue;
 
-                    auto bettingTx = ParseBettingTx(txout);
-
-                    if (bettingTx == nullptr) continue;
+                    CBettingTx* bettingTx = txout.bettingTx.get();
 
                     auto txType = bettingTx->GetTxType();
                     // Peerless event OP RETURN transaction.
                     if (validOracleTx && txType == plEventTxType) {
-                        CPeerlessEventTx* pe = (CPeerlessEventTx*) bettingTx.get();
+                        CPeerlessEventTx* pe = (CPeerlessEventTx*) bettingTx;
 
                         // If the current event matches the result we can now set the odds.
                         if (result.nEventId == pe->nEventId) {
@@ -211,7 +314,7 @@ void GetBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vExpectedP
                     // Peerless update odds OP RETURN transaction.
                     if (eventFound && validOracleTx && txType == plUpdateOddsTxType) {
 
-                        CPeerlessUpdateOddsTx* puo = (CPeerlessUpdateOddsTx*) bettingTx.get();
+                        CPeerlessUpdateOddsTx* puo = (CPeerlessUpdateOddsTx*) bettingTx;
 
                         if (result.nEventId == puo->nEventId ) {
 
@@ -233,7 +336,7 @@ void GetBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vExpectedP
                     // Handle PSE, when we find a Spreads event on chain we need to update the Spreads odds.
                     if (eventFound && validOracleTx && txType == plSpreadsEventTxType) {
 
-                        CPeerlessSpreadsEventTx* pse = (CPeerlessSpreadsEventTx*) bettingTx.get();
+                        CPeerlessSpreadsEventTx* pse = (CPeerlessSpreadsEventTx*) bettingTx;
 
                         if (result.nEventId == pse->nEventId) {
 
@@ -287,7 +390,7 @@ void GetBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vExpectedP
 
                     // Handle PTE, when we find an Totals event on chain we need to update the Totals odds.
                     if (eventFound && validOracleTx && txType == plTotalsEventTxType) {
-                        CPeerlessTotalsEventTx* pte = (CPeerlessTotalsEventTx*) bettingTx.get();
+                        CPeerlessTotalsEventTx* pte = (CPeerlessTotalsEventTx*) bettingTx;
                         if (result.nEventId == pte->nEventId) {
 
                             UpdateTotals = true;
@@ -318,7 +421,7 @@ void GetBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vExpectedP
 
                     // If we encounter the result after cycling the chain then we dont need go any furture so finish the payout.
                     if (eventFound && validOracleTx && txType == plResultTxType) {
-                        CPeerlessResultTx* pr = (CPeerlessResultTx*) bettingTx.get();
+                        CPeerlessResultTx* pr = (CPeerlessResultTx*) bettingTx;
                         if (result.nEventId == pr->nEventId ) {
                             return;
                         }
@@ -330,9 +433,9 @@ void GetBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vExpectedP
                         // Bet OP RETURN transaction.
                         if (txType == plBetTxType) {
 
-                            CPeerlessBetTx* pb = (CPeerlessBetTx*) bettingTx.get();
+                            CPeerlessBetTx* pb = (CPeerlessBetTx*) bettingTx;
 
-                            PeerlessBetKey betKey{nHeight, COutPoint(tx.GetHash(), i)};
+                            PeerlessBetKey betKey{nHeight, COutPoint(tx.txHash, txout.nOut)};
 
                             CAmount payout = 0 * COIN;
 
@@ -403,8 +506,7 @@ void GetBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vExpectedP
 
                                 // Get the users payout address from the vin of the bet TX they used to place the bet.
                                 CTxDestination payoutAddress;
-                                const CTxIn &txin = tx.vin[0];
-                                COutPoint prevout = txin.prevout;
+                                const COutPoint &prevout = tx.prevout;
 
                                 uint256 hashBlock;
                                 CTransaction txPrev;
@@ -501,13 +603,15 @@ void GetBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vExpectedP
  *
  * @return payout vector.
  */
-void GetCGLottoBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vExpectedPayouts, std::vector<CPayoutInfoDB>& vPayoutsInfo)
+void GetCGLottoBetPayoutsV2(CBettingsView &bettingsViewCache, const int nNewBlockHeight, std::vector<CBetOut>& vExpectedPayouts, std::vector<CPayoutInfoDB>& vPayoutsInfo)
 {
     const int nLastBlockHeight = nNewBlockHeight - 1;
 
     // get results from prev block
     std::vector<CChainGamesResultDB> allChainGames;
-    GetCGLottoEventResults(nLastBlockHeight, allChainGames);
+    GetCGLottoEventResults(bettingsViewCache, nLastBlockHeight, allChainGames);
+
+    const bool fUseWindow = SlideBettingBlocksV2(nLastBlockHeight);
 
     // Find payout for each CGLotto game
     for (unsigned int currResult = 0; currResult < allChainGames.size(); currResult++) {
@@ -530,33 +634,26 @@ void GetCGLottoBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vEx
 
         while (BlocksIndex) {
 
-            CBlock block;
-            ReadBlockFromDisk(block, BlocksIndex);
-            time_t transactionTime = block.nTime;
+            CBettingBlockV2Ref block = GetBettingBlockV2(BlocksIndex, fUseWindow);
+            time_t transactionTime = block->nTime;
 
-            for (CTransaction &tx : block.vtx) {
+            for (const CBettingBlockV2::CBettingTxV2 &tx : block->vtx) {
 
                 // Ensure if event TX that has it been posted by Oracle wallet.
-                const CTxIn &txin = tx.vin[0];
-                COutPoint prevout = txin.prevout;
+                const COutPoint &prevout = tx.prevout;
 
                 uint256 hashBlock;
                 CTransaction txPrev;
 
-                uint256 txHash = tx.GetHash();
-
-                bool validTX = IsValidOracleTx(txin, BlocksIndex->nHeight);
+                bool validTX = tx.validOracleTx;
 
-                // Check all TX vouts for an OP RETURN.
-                for (unsigned int i = 0; i < tx.vout.size(); i++) {
+                // Check all TX OP RETURN vouts.
+                for (const CBettingBlockV2::CBettingOut &txout : tx.vOuts) {
 
-                    const CTxOut &txout = tx.vout[i];
                     CAmount betAmount = txout.nValue;
 
-                    PeerlessBetKey betKey{static_cast<uint32_t>(BlocksIndex->nHeight), COutPoint{txHash, static_cast<uint32_t>(i)}};
-                    auto cgBettingTx = ParseBettingTx(txout);
-
-                    if (cgBettingTx == nullptr) continue;
+                    PeerlessBetKey betKey{static_cast<uint32_t>(BlocksIndex->nHeight), COutPoint{tx.txHash, txout.nOut}};
+                    CBettingTx* cgBettingTx = txout.bettingTx.get();
 
                     // If bet was placed less than 20 mins before event start or after event start discard it.
                     if (eventStart > 0 && transactionTime > (eventStart - Params().BetPlaceTimeoutBlocks())) {
@@ -569,7 +666,7 @@ void GetCGLottoBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vEx
                     // Find most recent CGLotto event
                     if (validTX && txType == cgEventTxType) {
 
-                        CChainGamesEventTx* chainGameEvt = (CChainGamesEventTx*) cgBettingTx.get();
+                        CChainGamesEventTx* chainGameEvt = (CChainGamesEventTx*) cgBettingTx;
                         if (chainGameEvt->nEventId == currentEventID) {
                             eventFee = chainGameEvt->nEntryFee * COIN;
                             currentEventFound = true;
@@ -579,16 +676,13 @@ void GetCGLottoBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vEx
                     // Find most recent CGLotto bet once the event has been found
                     if (currentEventFound && txType == cgBetTxType) {
 
-                        CChainGamesBetTx* chainGamesBet = (CChainGamesBetTx*) cgBettingTx.get();
+                        CChainGamesBetTx* chainGamesBet = (CChainGamesBetTx*) cgBettingTx;
 
                         uint32_t eventId = chainGamesBet->nEventId;
 
                         // If current event ID matches result ID add bettor to candidate array
                         if (eventId == currentEventID) {
 
-                            CTxDestination address;
-                            ExtractDestination(tx.vout[0].scriptPubKey, address);
-
                             //Check Entry fee matches the bet amount
                             if (eventFee == betAmount) {
 
@@ -10,6 +10,7 @@
 
 class CBetOut;
 class CPayoutInfoDB;
+class CBettingsView;
 
 class LegacyPayout
 {
@@ -35,8 +36,8 @@ public:
 void GetPLRewardPayoutsV2(const uint32_t nNewBlockHeight, std::vector<CBetOut>& vExpectedPayouts, std::vector<CPayoutInfoDB>& vPayoutsInfo);
 
 /** Get the peerless winning bets from the block chain and return the payout vector. **/
-void GetBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vExpectedPayouts, std::vector<CPayoutInfoDB>& vPayoutsInfo);
+void GetBetPayoutsV2(CBettingsView &bettingsViewCache, const int nNewBlockHeight, std::vector<CBetOut>& vExpectedPayouts, std::vector<CPayoutInfoDB>& vPayoutsInfo);
 /** Get the chain games winner and return the payout vector. **/
-void GetCGLottoBetPayoutsV2(const int nNewBlockHeight, std::vector<CBetOut>& vExpectedPayouts, std::vector<CPayoutInfoDB>& vPayoutsInfo);
+void GetCGLottoBetPayoutsV2(CBettingsView &bettingsViewCache, const int nNewBlockHeight, std::vector<CBetOut>& vExpectedPayouts, std::vector<CPayoutInfoDB>& vPayoutsInfo);
 
 #endif // WAGERR_V2_BET_H
\ No newline at end of file
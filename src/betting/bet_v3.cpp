@@ -7,6 +7,7 @@
 #include <betting/bet_v3.h>
 #include <betting/bet_db.h>
 #include <betting/oracles.h>
+#include <checkqueue.h>
 #include <main.h>
 #include <util.h>
 #include <base58.h>
@@ -53,9 +54,237 @@ uint32_t GetBetSearchStartHeight(int nHeight) {
     }
 }
 
+/**
+ * Snapshot of a peerless bet and the outcome of its evaluation against a resulted event.
+ */
+struct CPeerlessBetEval
+{
+    PeerlessBetKey key;
+    CPeerlessBetDB bet;
+    bool completedBet{false};
+    bool legHalfLose{false};
+    bool legHalfWin{false};
+    bool legRefund{false};
+    // {onchainOdds, effectiveOdds}
+    std::pair<uint32_t, uint32_t> finalOdds{0, 0};
+    CAmount effectivePayout{0};
+    CAmount grossPayout{0};
+    // parlay bet with legs resolution kept in db
+    bool fParlayLegs{false};
+    bool fParlayLegsChanged{false};
+    CParlayLegsDB parlayLegs;
+};
+
+/**
+ * Data shared by the evaluations of the bets of one block.
+ */
+struct CPeerlessBetEvalContext
+{
+    // results of the parlay legs, loaded once per block
+    std::map<uint32_t, CPeerlessResultDB> mapLegResults;
+    // events resulted in the previous block
+    std::set<uint32_t> setResultedEvents;
+    int nLastBlockHeight;
+    bool fWagerrProtocolV3;
+};
+
+static std::pair<uint32_t, uint32_t> GetParlayLegOdds(const CPeerlessBetDB& uniBet, const uint32_t idx, const CPeerlessResultDB& res, const bool fWagerrProtocolV3)
+{
+    const uint64_t refundOdds{BET_ODDSDIVISOR};
+    const CPeerlessLegDB &leg = uniBet.legs[idx];
+    const CPeerlessBaseEventDB &lockedEvent = uniBet.lockedEvents[idx];
+
+    // if bet placed before 2 mins of event started - refund this bet
+    if (lockedEvent.nStartTime > 0 && uniBet.betTime > ((int64_t)lockedEvent.nStartTime - Params().BetPlaceTimeoutBlocks())) {
+        return fWagerrProtocolV3 ? std::pair<uint32_t, uint32_t>{refundOdds, refundOdds} : std::pair<uint32_t, uint32_t>{0, 0};
+    }
+    return GetBetOdds(leg, lockedEvent, res, fWagerrProtocolV3);
+}
+
+/**
+ * Evaluates the bet snapshot against the result. Only reads the snapshot and the
+ * already loaded results of the bet legs, so bets can be evaluated concurrently.
+ */
+static void EvaluatePeerlessBet(CPeerlessBetEval& eval, const CPeerlessResultDB& result, const CPeerlessBetEvalContext& context)
+{
+    const uint64_t refundOdds{BET_ODDSDIVISOR};
+    const int nLastBlockHeight = context.nLastBlockHeight;
+    const bool fWagerrProtocolV3 = context.fWagerrProtocolV3;
+    const CPeerlessBetDB& uniBet = eval.bet;
+    bool& completedBet = eval.completedBet;
+    bool& legHalfLose = eval.legHalfLose;
+    bool& legHalfWin = eval.legHalfWin;
+    bool& legRefund = eval.legRefund;
+    std::pair<uint32_t, uint32_t>& finalOdds = eval.finalOdds;
+
+    // parlay bet
+    if (uniBet.legs.size() > 1) {
+        bool resultFound = false;
+        for (auto leg : uniBet.legs) {
+            // if we found one result for parlay - check win condition for this and each other legs
+            if (leg.nEventId == result.nEventId) {
+                resultFound = true;
+                break;
+            }
+        }
+        if (resultFound) {
+            // resolve the legs by the results posted in the previous block
+            if (eval.fParlayLegs) {
+                for (uint32_t idx = 0; idx < uniBet.legs.size(); idx++) {
+                    const uint32_t nEventId = uniBet.legs[idx].nEventId;
+                    if (eval.parlayLegs.vLegs[idx].IsResolved() || !context.setResultedEvents.count(nEventId)) continue;
+                    auto itRes = context.mapLegResults.find(nEventId);
+                    if (itRes == context.mapLegResults.end()) continue;
+                    eval.parlayLegs.ResolveLeg(idx, nLastBlockHeight + 1, GetParlayLegOdds(uniBet, idx, itRes->second, fWagerrProtocolV3));
+                    eval.fParlayLegsChanged = true;
+                }
+            }
+            // make assumption that parlay is completed and this result is last
+            completedBet = true;
+            // find all results for all legs
+            bool firstOddMultiply = true;
+            for (uint32_t idx = 0; idx < uniBet.legs.size(); idx++) {
+                const CPeerlessLegDB &leg = uniBet.legs[idx];
+                const CPeerlessBaseEventDB &lockedEvent = uniBet.lockedEvents[idx];
+                // {onchainOdds, effectiveOdds}
+                std::pair<uint32_t, uint32_t> betOdds;
+                // skip this bet if incompleted (can't find one result)
+                if (eval.fParlayLegs) {
+                    const CParlayLegDB &legState = eval.parlayLegs.vLegs[idx];
+                    if (!legState.IsResolved()) {
+                        completedBet = false;
+                        break;
+                    }
+                    betOdds = std::pair<uint32_t, uint32_t>{legState.nOnchainOdds, legState.nEffectiveOdds};
+                }
+                else {
+                    auto itRes = context.mapLegResults.find(leg.nEventId);
+                    if (itRes == context.mapLegResults.end()) {
+                        completedBet = false;
+                        break;
+                    }
+                    betOdds = GetParlayLegOdds(uniBet, idx, itRes->second, fWagerrProtocolV3);
+                }
+
+                if (betOdds.first == 0) { }
+                else if (betOdds.first == refundOdds) {
+                    legRefund = true;
+                }
+                else if (betOdds.first == refundOdds / 2) {
+                    legHalfLose = true;
+                }
+                else if (betOdds.first < GetBetPotentialOdds(leg, lockedEvent)) {
+                    legHalfWin = true;
+                }
+                // multiply odds
+                if (firstOddMultiply) {
+                    finalOdds.first = betOdds.first;
+                    finalOdds.second = betOdds.second ;
+                    firstOddMultiply = false;
+                }
+                else {
+                    finalOdds.first = static_cast<uint32_t>(((uint64_t) finalOdds.first * betOdds.first) / BET_ODDSDIVISOR);
+                    finalOdds.second = static_cast<uint32_t>(((uint64_t) finalOdds.second * betOdds.second) / BET_ODDSDIVISOR);
+                }
+            }
+        }
+    }
+    // single bet
+    else if (uniBet.legs.size() == 1) {
+        const CPeerlessLegDB &singleBet = uniBet.legs[0];
+        const CPeerlessBaseEventDB &lockedEvent = uniBet.lockedEvents[0];
+
+        if (singleBet.nEventId == result.nEventId) {
+            completedBet = true;
+
+            // if bet placed before 2 mins of event started - refund this bet
+            if (lockedEvent.nStartTime > 0 && uniBet.betTime > ((int64_t)lockedEvent.nStartTime - Params().BetPlaceTimeoutBlocks())) {
+                if (fWagerrProtocolV3) {
+                    finalOdds = std::pair<uint32_t, uint32_t>{refundOdds, refundOdds};
+                } else {
+                    finalOdds = std::pair<uint32_t, uint32_t>{0, 0};
+                }
+            } else if ((!fWagerrProtocolV3) && nLastBlockHeight - lockedEvent.nEventCreationHeight > Params().BetBlocksIndexTimespanV2()) {
+                finalOdds = std::pair<uint32_t, uint32_t>{0, 0};
+            }
+            else {
+                finalOdds = GetBetOdds(singleBet, lockedEvent, result, fWagerrProtocolV3);
+            }
+
+            if (finalOdds.first == 0) { }
+            else if (finalOdds.first == refundOdds) {
+                legRefund = true;
+            }
+            else if (finalOdds.first == refundOdds / 2) {
+                legHalfLose = true;
+            }
+            else if (finalOdds.first < GetBetPotentialOdds(singleBet, lockedEvent)) {
+                legHalfWin = true;
+            }
+        }
+    }
+
+    if (completedBet) {
+        if (uniBet.betAmount < (Params().MinBetPayoutRange() * COIN) || uniBet.betAmount > (Params().MaxBetPayoutRange() * COIN)) {
+            finalOdds = fWagerrProtocolV3 ? std::pair<uint32_t, uint32_t>{refundOdds, refundOdds} : std::pair<uint32_t, uint32_t>{0, 0};
+        }
+
+        if (!fWagerrProtocolV3) {
+            CAmount burn;
+            CalculatePayoutBurnAmounts(uniBet.betAmount, finalOdds.first, eval.effectivePayout, burn);
+        }
+        else {
+            eval.effectivePayout = uniBet.betAmount * finalOdds.second / BET_ODDSDIVISOR;
+            eval.grossPayout = uniBet.betAmount * finalOdds.first / BET_ODDSDIVISOR;
+        }
+    }
+}
+
+/**
+ * Closure representing one bet evaluation.
+ * Note that this stores pointers to the bet snapshot, result and context, which must outlive the check.
+ */
+class CPeerlessBetCheck
+{
+private:
+    CPeerlessBetEval* pEval;
+    const CPeerlessResultDB* pResult;
+    const CPeerlessBetEvalContext* pContext;
+
+public:
+    CPeerlessBetCheck() : pEval(nullptr), pResult(nullptr), pContext(nullptr) {}
+    CPeerlessBetCheck(CPeerlessBetEval& evalIn, const CPeerlessResultDB& resultIn, const CPeerlessBetEvalContext& contextIn) :
+        pEval(&evalIn), pResult(&resultIn), pContext(&contextIn) {}
+
+    bool operator()()
+    {
+        EvaluatePeerlessBet(*pEval, *pResult, *pContext);
+        return true;
+    }
+
+    void swap(CPeerlessBetCheck& check)
+    {
+        std::swap(pEval, check.pEval);
+        std::swap(pResult, check.pResult);
+        std::swap(pContext, check.pContext);
+    }
+};
+
+static CCheckQueue<CPeerlessBetCheck> betcheckqueue(128);
+
+void ThreadBetCheck()
+{
+    RenameThread("wagerr-betcheck");
+    betcheckqueue.Thread();
+}
+
 /**
  * Creates the bet payout vector for all winning CUniversalBet bets.
  *
+ * Bets of each result are read serially, evaluated concurrently by the bet check
+ * threads (-par) and then merged in the order of the event bets index, so the
+ * payouts and the updated bets don't depend on the number of threads.
+ *
  * @return payout vector, payouts info vector.
  */
 void GetPLBetPayoutsV3(CBettingsView &bettingsViewCache, const int nNewBlockHeight, std::vector<CBetOut>& vExpectedPayouts, std::vector<CPayoutInfoDB>& vPayoutsInfo)
@@ -65,12 +294,21 @@ void GetPLBetPayoutsV3(CBettingsView &bettingsViewCache, const int nNewBlockHeig
     uint64_t refundOdds{BET_ODDSDIVISOR};
 
     // Get all the results posted in the prev block.
-    std::vector<CPeerlessResultDB> results = GetEventResults(nLastBlockHeight);
+    std::vector<CPeerlessResultDB> results = GetEventResults(bettingsViewCache, nLastBlockHeight);
 
     bool fWagerrProtocolV3 = nLastBlockHeight >= Params().WagerrProtocolV3StartHeight();
 
     CAmount effectivePayoutsSum, grossPayoutsSum = effectivePayoutsSum = 0;
 
+    CPeerlessBetEvalContext context;
+    context.nLastBlockHeight = nLastBlockHeight;
+    context.fWagerrProtocolV3 = fWagerrProtocolV3;
+    for (const CPeerlessResultDB& result : results) {
+        context.setResultedEvents.insert(result.nEventId);
+    }
+    // legs of parlays placed since this height are resolved when their results are posted
+    const uint32_t nParlayLegsStartHeight = bettingsViewCache.GetParlayLegsStartHeight();
+
     LogPrint("wagerr", "Start generating peerless bets payouts...\n");
 
     for (auto result : results) {
@@ -83,129 +321,76 @@ void GetPLBetPayoutsV3(CBettingsView &bettingsViewCache, const int nNewBlockHeig
         bool legHalfLose = false;
         bool legHalfWin = false;
         bool legRefund = false;
-        auto it = bettingsViewCache.bets->NewIterator();
         std::vector<std::pair<PeerlessBetKey, CPeerlessBetDB>> vEntriesToUpdate;
-        for (it->Seek(CBettingDB::DbTypeToBytes(PeerlessBetKey{static_cast<uint32_t>(startHeight), COutPoint()})); it->Valid(); it->Next()) {
-            PeerlessBetKey uniBetKey;
-            CPeerlessBetDB uniBet;
-            CBettingDB::BytesToDbType(it->Key(), uniBetKey);
-            CBettingDB::BytesToDbType(it->Value(), uniBet);
+        std::vector<CPeerlessBetEval> vBetEvals;
+        // visit only bets which have leg with resulted event
+        for (PeerlessBetKey& uniBetKey : bettingsViewCache.GetEventBets(result.nEventId, startHeight)) {
+            CPeerlessBetEval eval;
+            eval.key = uniBetKey;
+            if (!bettingsViewCache.bets->Read(uniBetKey, eval.bet)) {
+                LogPrintf("%s - Failed to find indexed bet %s\n", __func__, uniBetKey.outPoint.ToStringShort());
+                continue;
+            }
             // skip if bet is already handled
-            if (fWagerrProtocolV3 && uniBet.IsCompleted()) continue;
-
-            bool completedBet = false;
-            // {onchainOdds, effectiveOdds}
-            std::pair<uint32_t, uint32_t> finalOdds{0, 0};
-
-            // parlay bet
-            if (uniBet.legs.size() > 1) {
-                bool resultFound = false;
-                for (auto leg : uniBet.legs) {
-                    // if we found one result for parlay - check win condition for this and each other legs
-                    if (leg.nEventId == result.nEventId) {
-                        resultFound = true;
-                        break;
+            if (fWagerrProtocolV3 && eval.bet.IsCompleted()) continue;
+
+            if (eval.bet.legs.size() > 1) {
+                if (fWagerrProtocolV3 && uniBetKey.blockHeight >= nParlayLegsStartHeight) {
+                    eval.fParlayLegs = true;
+                    if (!bettingsViewCache.parlayLegs->Read(uniBetKey, eval.parlayLegs)) {
+                        eval.parlayLegs = CParlayLegsDB(eval.bet.legs.size());
                     }
                 }
-                if (resultFound) {
-                    // make assumption that parlay is completed and this result is last
-                    completedBet = true;
-                    // find all results for all legs
-                    bool firstOddMultiply = true;
-                    for (uint32_t idx = 0; idx < uniBet.legs.size(); idx++) {
-                        CPeerlessLegDB &leg = uniBet.legs[idx];
-                        CPeerlessBaseEventDB &lockedEvent = uniBet.lockedEvents[idx];
-                        // skip this bet if incompleted (can't find one result)
-                        CPeerlessResultDB res;
-                        if (bettingsViewCache.results->Read(ResultKey{leg.nEventId}, res)) {
-                            // {onchainOdds, effectiveOdds}
-                            std::pair<uint32_t, uint32_t> betOdds;
-                            // if bet placed before 2 mins of event started - refund this bet
-                            if (lockedEvent.nStartTime > 0 && uniBet.betTime > ((int64_t)lockedEvent.nStartTime - Params().BetPlaceTimeoutBlocks())) {
-                                betOdds = fWagerrProtocolV3 ? std::pair<uint32_t, uint32_t>{refundOdds, refundOdds} : std::pair<uint32_t, uint32_t>{0, 0};
-                            }
-                            else {
-                                betOdds = GetBetOdds(leg, lockedEvent, res, fWagerrProtocolV3);
-                            }
-
-                            if (betOdds.first == 0) { }
-                            else if (betOdds.first == refundOdds) {
-                                legRefund = true;
-                            }
-                            else if (betOdds.first == refundOdds / 2) {
-                                legHalfLose = true;
-                            }
-                            else if (betOdds.first < GetBetPotentialOdds(leg, lockedEvent)) {
-                                legHalfWin = true;
-                            }
-                            // multiply odds
-                            if (firstOddMultiply) {
-                                finalOdds.first = betOdds.first;
-                                finalOdds.second = betOdds.second ;
-                                firstOddMultiply = false;
-                            }
-                            else {
-                                finalOdds.first = static_cast<uint32_t>(((uint64_t) finalOdds.first * betOdds.first) / BET_ODDSDIVISOR);
-                                finalOdds.second = static_cast<uint32_t>(((uint64_t) finalOdds.second * betOdds.second) / BET_ODDSDIVISOR);
-                            }
-                        }
-                        else {
-                            completedBet = false;
-                            break;
-                        }
+                for (uint32_t idx = 0; idx < eval.bet.legs.size(); idx++) {
+                    const uint32_t nEventId = eval.bet.legs[idx].nEventId;
+                    // only results of unresolved legs posted in the previous block are needed
+                    if (eval.fParlayLegs && (eval.parlayLegs.vLegs[idx].IsResolved() || !context.setResultedEvents.count(nEventId))) continue;
+                    if (context.mapLegResults.count(nEventId)) continue;
+                    CPeerlessResultDB res;
+                    if (bettingsViewCache.results->Read(ResultKey{nEventId}, res)) {
+                        context.mapLegResults.emplace(nEventId, res);
                     }
                 }
             }
-            // single bet
-            else if (uniBet.legs.size() == 1) {
-                CPeerlessLegDB &singleBet = uniBet.legs[0];
-                CPeerlessBaseEventDB &lockedEvent = uniBet.lockedEvents[0];
-
-                if (singleBet.nEventId == result.nEventId) {
-                    completedBet = true;
-
-                    // if bet placed before 2 mins of event started - refund this bet
-                    if (lockedEvent.nStartTime > 0 && uniBet.betTime > ((int64_t)lockedEvent.nStartTime - Params().BetPlaceTimeoutBlocks())) {
-                        if (fWagerrProtocolV3) {
-                            finalOdds = std::pair<uint32_t, uint32_t>{refundOdds, refundOdds};
-                        } else {
-                            finalOdds = std::pair<uint32_t, uint32_t>{0, 0};
-                        }
-                    } else if ((!fWagerrProtocolV3) && nLastBlockHeight - lockedEvent.nEventCreationHeight > Params().BetBlocksIndexTimespanV2()) {
-                        finalOdds = std::pair<uint32_t, uint32_t>{0, 0};
-                    }
-                    else {
-                        finalOdds = GetBetOdds(singleBet, lockedEvent, result, fWagerrProtocolV3);
-                    }
+            vBetEvals.emplace_back(std::move(eval));
+        }
 
-                    if (finalOdds.first == 0) { }
-                    else if (finalOdds.first == refundOdds) {
-                        legRefund = true;
-                    }
-                    else if (finalOdds.first == refundOdds / 2) {
-                        legHalfLose = true;
-                    }
-                    else if (finalOdds.first < GetBetPotentialOdds(singleBet, lockedEvent)) {
-                        legHalfWin = true;
-                    }
+        {
+            CCheckQueueControl<CPeerlessBetCheck> control(nScriptCheckThreads ? &betcheckqueue : nullptr);
+            std::vector<CPeerlessBetCheck> vChecks;
+            vChecks.reserve(vBetEvals.size());
+            for (CPeerlessBetEval& eval : vBetEvals) {
+                CPeerlessBetCheck check(eval, result, context);
+                if (nScriptCheckThreads) {
+                    vChecks.emplace_back();
+                    check.swap(vChecks.back());
+                } else {
+                    check();
                 }
             }
+            control.Add(vChecks);
+            control.Wait();
+        }
 
-            if (completedBet) {
-                if (uniBet.betAmount < (Params().MinBetPayoutRange() * COIN) || uniBet.betAmount > (Params().MaxBetPayoutRange() * COIN)) {
-                    finalOdds = fWagerrProtocolV3 ? std::pair<uint32_t, uint32_t>{refundOdds, refundOdds} : std::pair<uint32_t, uint32_t>{0, 0};
-                }
+        for (CPeerlessBetEval& eval : vBetEvals) {
+            PeerlessBetKey& uniBetKey = eval.key;
+            CPeerlessBetDB& uniBet = eval.bet;
+            const std::pair<uint32_t, uint32_t>& finalOdds = eval.finalOdds;
+            const CAmount effectivePayout = eval.effectivePayout;
 
-                CAmount effectivePayout, grossPayout, burn;
+            // leg flags are accumulated in the bets order
+            legHalfLose |= eval.legHalfLose;
+            legHalfWin |= eval.legHalfWin;
+            legRefund |= eval.legRefund;
 
-                if (!fWagerrProtocolV3) {
-                    CalculatePayoutBurnAmounts(uniBet.betAmount, finalOdds.first, effectivePayout, burn);
-                }
-                else {
-                    effectivePayout = uniBet.betAmount * finalOdds.second / BET_ODDSDIVISOR;
-                    grossPayout = uniBet.betAmount * finalOdds.first / BET_ODDSDIVISOR;
+            if (eval.fParlayLegsChanged) {
+                bettingsViewCache.SaveParlayLegs(uniBetKey, eval.parlayLegs);
+            }
+
+            if (eval.completedBet) {
+                if (fWagerrProtocolV3) {
                     effectivePayoutsSum += effectivePayout;
-                    grossPayoutsSum += grossPayout;
+                    grossPayoutsSum += eval.grossPayout;
                 }
 
                 if (effectivePayout > 0) {
@@ -247,6 +432,7 @@ void GetPLBetPayoutsV3(CBettingsView &bettingsViewCache, const int nNewBlockHeig
         }
         for (auto pair : vEntriesToUpdate) {
             bettingsViewCache.bets->Update(pair.first, pair.second);
+            bettingsViewCache.SaveCompletedBet(nNewBlockHeight, pair.first);
         }
     }
 
@@ -281,18 +467,19 @@ void GetQuickGamesBetPayouts(CBettingsView& bettingsViewCache, const int nNewBlo
     CBlockIndex *blockIndex = chainActive[nLastBlockHeight];
     std::map<std::string, CAmount> mExpectedRewards;
     uint32_t blockHeight = static_cast<uint32_t>(nLastBlockHeight);
+    // bets are keyed by the block height first, so bets of the block are one range of keys
+    std::vector<std::pair<QuickGamesBetKey, CQuickGamesBetDB>> vBets;
     auto it = bettingsViewCache.quickGamesBets->NewIterator();
-    std::vector<std::pair<QuickGamesBetKey, CQuickGamesBetDB>> vEntriesToUpdate;
     for (it->Seek(CBettingDB::DbTypeToBytes(QuickGamesBetKey{blockHeight, COutPoint()})); it->Valid(); it->Next()) {
         QuickGamesBetKey qgKey;
         CQuickGamesBetDB qgBet;
 
-        CBettingDB::BytesToDbType(it->Key(), qgKey);
+        CBettingDB::BytesToDbType(it->KeySlice(), qgKey);
 
         if (qgKey.blockHeight != blockHeight)
             break;
 
-        CBettingDB::BytesToDbType(it->Value(), qgBet);
+        CBettingDB::BytesToDbType(it->ValueSlice(), qgBet);
         // skip if already handled
         if (qgBet.IsCompleted())
             continue;
@@ -301,18 +488,44 @@ void GetQuickGamesBetPayouts(CBettingsView& bettingsViewCache, const int nNewBlo
         if (qgBet.gameType >= Params().QuickGamesArr().size())
             continue;
 
-        // handle bet by specific game handler from quick games framework
+        vBets.emplace_back(qgKey, qgBet);
+    }
+
+    // handle bets of each game at once by specific game handler from quick games framework
+    std::vector<uint32_t> vOdds(vBets.size());
+    for (uint32_t gameType = 0; gameType < Params().QuickGamesArr().size(); gameType++) {
+        std::vector<const std::vector<unsigned char>*> vBetInfos;
+        std::vector<size_t> vBetIdxs;
+        for (size_t i = 0; i < vBets.size(); i++) {
+            if (vBets[i].second.gameType != gameType) continue;
+            vBetInfos.push_back(&vBets[i].second.vBetInfo);
+            vBetIdxs.push_back(i);
+        }
+        if (vBetInfos.empty()) continue;
+        std::vector<uint32_t> vGameOdds;
+        Params().QuickGamesArr()[gameType].batchHandler(vBetInfos, blockIndex->hashProofOfStake, vGameOdds);
+        for (size_t i = 0; i < vBetIdxs.size(); i++) {
+            vOdds[vBetIdxs[i]] = vGameOdds[i];
+        }
+    }
+
+    std::string DevPayoutAddr;
+    std::string OMNOPayoutAddr;
+    const bool fFeePayoutAddresses = !vBets.empty() && GetFeePayoutAddresses(nNewBlockHeight, DevPayoutAddr, OMNOPayoutAddr);
+
+    std::vector<std::pair<QuickGamesBetKey, CQuickGamesBetDB>> vEntriesToUpdate;
+    for (size_t i = 0; i < vBets.size(); i++) {
+        QuickGamesBetKey& qgKey = vBets[i].first;
+        CQuickGamesBetDB& qgBet = vBets[i].second;
         const CQuickGamesView& gameView = Params().QuickGamesArr()[qgBet.gameType];
         // if odds == 0 - bet lose, if odds > OddsDivisor - bet win, if odds == BET_ODDSDIVISOR - bet refunded
-        uint32_t odds = gameView.handler(qgBet.vBetInfo, blockIndex->hashProofOfStake);
+        uint32_t odds = vOdds[i];
         CAmount winningsPermille = qgBet.betAmount * odds;
         CAmount feePermille = winningsPermille > 0 ? (qgBet.betAmount * (odds - BET_ODDSDIVISOR) / 1000 * gameView.nFeePermille) : 0;
         CAmount payout = winningsPermille > 0 ? (winningsPermille - feePermille) / BET_ODDSDIVISOR : 0;
 
         if (payout > 0) {
-            std::string DevPayoutAddr;
-            std::string OMNOPayoutAddr;
-            if (!GetFeePayoutAddresses(nNewBlockHeight, DevPayoutAddr, OMNOPayoutAddr)) {
+            if (!fFeePayoutAddresses) {
                 LogPrintf("Unable to find oracle, skipping payouts\n");
                 continue;
             }
@@ -370,7 +583,7 @@ void GetCGLottoBetPayoutsV3(CBettingsView &bettingsViewCache, const int nNewBloc
     // Get all the results posted in the prev block.
     std::vector<CChainGamesResultDB> results;
 
-    GetCGLottoEventResults(nLastBlockHeight, results);
+    GetCGLottoEventResults(bettingsViewCache, nLastBlockHeight, results);
 
     std::vector<std::pair<ChainGamesBetKey, CChainGamesBetDB>> vEntriesToUpdate;
 
@@ -401,8 +614,8 @@ void GetCGLottoBetPayoutsV3(CBettingsView &bettingsViewCache, const int nNewBloc
         for (it->Seek(CBettingDB::DbTypeToBytes(ChainGamesBetKey{static_cast<uint32_t>(startHeight), COutPoint()})); it->Valid(); it->Next()) {
             ChainGamesBetKey cgBetKey;
             CChainGamesBetDB cgBet;
-            CBettingDB::BytesToDbType(it->Key(), cgBetKey);
-            CBettingDB::BytesToDbType(it->Value(), cgBet);
+            CBettingDB::BytesToDbType(it->KeySlice(), cgBetKey);
+            CBettingDB::BytesToDbType(it->ValueSlice(), cgBet);
 
             if (cgBet.IsCompleted() ||
                     cgBet.nEventId != result.nEventId ||
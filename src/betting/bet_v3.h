@@ -20,6 +20,9 @@ class CChainGamesResultDB;
 
 void GetPLRewardPayoutsV3(const uint32_t nNewBlockHeight, const CAmount fee, std::vector<CBetOut>& vExpectedPayouts, std::vector<CPayoutInfoDB>& vPayoutsInfo);
 
+/** Run an instance of the peerless bet evaluation thread */
+void ThreadBetCheck();
+
 /** Using betting database for handle bets **/
 void GetPLBetPayoutsV3(CBettingsView &bettingsViewCache, const int nNewBlockHeight, std::vector<CBetOut>& vExpectedPayouts, std::vector<CPayoutInfoDB>& vPayoutsInfo);
 
@@ -7,22 +7,46 @@
 #include <script/standard.h>
 #include <base58.h>
 
+// Decode the oracle address with the prefixes of the network which owns it
+bool COracle::InitKeyID(const CChainParams& params)
+{
+    return CBitcoinAddress(this->strAddress).GetKeyID(this->keyID, params);
+}
+
 // Returns if the current oracle is active according to the specified block height
-bool COracle::IsActive(const int& nHeight)
+bool COracle::IsActive(const int& nHeight) const
 {
     return (nHeight >= this->nStartHeight && nHeight < this->nEndHeight);
 }
 
 // Validate the tx
-bool COracle::IsMyOracleTx(const std::string txAddress, const int& nTxHeight)
+bool COracle::IsMyOracleTx(const std::string txAddress, const int& nTxHeight) const
 {
     if (!this->IsActive(nTxHeight)) return false;
     return txAddress == this->strAddress;
 }
 
+// Validate the tx by the key id of its input address
+bool COracle::IsMyOracleTx(const CKeyID& txKeyID, const int& nTxHeight) const
+{
+    if (!this->IsActive(nTxHeight)) return false;
+    return txKeyID == this->keyID;
+}
+
+// Returns if the key id belongs to an oracle which is active at the specified block height
+bool IsOracleKeyID(const CKeyID& keyID, const int& nHeight)
+{
+    const OracleKeyMap& mapOracleKeys = Params().OracleKeys();
+    auto range = mapOracleKeys.equal_range(keyID);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.IsMyOracleTx(keyID, nHeight)) return true;
+    }
+    return false;
+}
+
 bool GetFeePayoutScripts(const int& nHeight, CScript& DevPayoutScript, CScript& OMNOPayoutScript)
 {
-    for (auto oracle : Params().Oracles()) {
+    for (const COracle& oracle : Params().Oracles()) {
         if (oracle.IsActive(nHeight)) {
             DevPayoutScript = GetScriptForDestination(CBitcoinAddress(oracle.getDevPayoutAddress()).Get());
             OMNOPayoutScript = GetScriptForDestination(CBitcoinAddress(oracle.getOMNOPayoutAddress()).Get());
@@ -34,7 +58,7 @@ bool GetFeePayoutScripts(const int& nHeight, CScript& DevPayoutScript, CScript&
 
 bool GetFeePayoutAddresses(const int& nHeight, std::string& DevPayoutAddress, std::string& OMNOPayoutAddress)
 {
-    for (auto oracle : Params().Oracles()) {
+    for (const COracle& oracle : Params().Oracles()) {
         if (oracle.IsActive(nHeight)) {
             DevPayoutAddress = oracle.getDevPayoutAddress();
             OMNOPayoutAddress = oracle.getOMNOPayoutAddress();
@@ -5,14 +5,20 @@
 #ifndef WAGERR_BET_ORACLE_H
 #define WAGERR_BET_ORACLE_H
 
+#include <pubkey.h>
+
 #include <string>
 #include <vector>
 
+#include <boost/unordered_map.hpp>
+
+class CChainParams;
 class CScript;
 
 class COracle {
 private:
     std::string strAddress;
+    CKeyID keyID;
     std::string strDevPayoutAddress;
     std::string strOMNOPayoutAddress;
     int nStartHeight;
@@ -25,13 +31,26 @@ public:
         strAddress(strAddress), strDevPayoutAddress(strDevPayoutAddress), strOMNOPayoutAddress(strOMNOPayoutAddress),
         nStartHeight(nStartHeight), nEndHeight(nEndHeight) {};
 
-    bool IsActive(const int& nHeight);
-    bool IsMyOracleTx(const std::string txAddress, const int& nTxHeight);
+    bool InitKeyID(const CChainParams& params);
+
+    bool IsActive(const int& nHeight) const;
+    bool IsMyOracleTx(const std::string txAddress, const int& nTxHeight) const;
+    bool IsMyOracleTx(const CKeyID& txKeyID, const int& nTxHeight) const;
+
+    const CKeyID& getKeyID() const { return this->keyID; }
 
-    const std::string getDevPayoutAddress() { return this->strDevPayoutAddress; }
-    const std::string getOMNOPayoutAddress() { return this->strOMNOPayoutAddress; }
+    const std::string getDevPayoutAddress() const { return this->strDevPayoutAddress; }
+    const std::string getOMNOPayoutAddress() const { return this->strOMNOPayoutAddress; }
 };
 
+struct OracleKeyHasher {
+    size_t operator()(const CKeyID& keyID) const { return keyID.GetLow64(); }
+};
+
+/** Oracles indexed by the key id of their address, several oracles may share one key over different height ranges */
+typedef boost::unordered_multimap<CKeyID, COracle, OracleKeyHasher> OracleKeyMap;
+
+bool IsOracleKeyID(const CKeyID& keyID, const int& nHeight);
 bool GetFeePayoutScripts(const int& nHeight, CScript& DevPayoutScript, CScript& OMNOPayoutScript);
 bool GetFeePayoutAddresses(const int& nHeight, std::string& DevPayoutAddress, std::string& OMNOPayoutAddress);
 
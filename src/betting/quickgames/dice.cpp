@@ -66,16 +66,10 @@ std::map<std::string, std::string> DiceBetInfoParser(std::vector<unsigned char>&
         std::make_pair("odds", std::to_string(DiceHandler(betInfo, seed)))};
 }
 
-uint32_t DiceHandler(std::vector<unsigned char>& betInfo, uint256 seed)
+/* Odds factor of the dice bet for the sum of the rolled dice */
+static uint32_t GetDiceOdds(const DiceBetInfo& info, uint64_t sum)
 {
     static const uint32_t NUMBER_OF_OUTCOMES = 36;
-    CDataStream ss{betInfo, SER_NETWORK, CLIENT_VERSION};
-    DiceBetInfo info;
-    ss >> info;
-
-    uint64_t firstDice = seed.Get64(0) % 6 + 1;
-    uint64_t secondDice = seed.Get64(1) % 6 + 1;
-    uint64_t sum = firstDice + secondDice;
 
     if (info.betType == qgDiceOdd && sum % 2 == 1) {
         return BET_ODDSDIVISOR * 2;
@@ -105,4 +99,36 @@ uint32_t DiceHandler(std::vector<unsigned char>& betInfo, uint256 seed)
     return 0;
 }
 
+/* Sum of the dice rolled by the seed */
+static uint64_t RollDice(const uint256& seed)
+{
+    uint64_t firstDice = seed.Get64(0) % 6 + 1;
+    uint64_t secondDice = seed.Get64(1) % 6 + 1;
+    return firstDice + secondDice;
+}
+
+uint32_t DiceHandler(std::vector<unsigned char>& betInfo, uint256 seed)
+{
+    CDataStream ss{betInfo, SER_NETWORK, CLIENT_VERSION};
+    DiceBetInfo info;
+    ss >> info;
+
+    return GetDiceOdds(info, RollDice(seed));
+}
+
+void DiceBatchHandler(const std::vector<const std::vector<unsigned char>*>& vBetInfos, uint256 seed, std::vector<uint32_t>& vOdds)
+{
+    // all bets of the block share the dice rolled by the block seed
+    const uint64_t sum = RollDice(seed);
+
+    vOdds.clear();
+    vOdds.reserve(vBetInfos.size());
+    for (const std::vector<unsigned char>* betInfo : vBetInfos) {
+        CDataStream ss{*betInfo, SER_NETWORK, CLIENT_VERSION};
+        DiceBetInfo info;
+        ss >> info;
+        vOdds.push_back(GetDiceOdds(info, sum));
+    }
+}
+
 } // namespace quickgames
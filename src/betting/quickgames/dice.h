@@ -48,6 +48,8 @@ std::map<std::string, std::string> DiceBetInfoParser(std::vector<unsigned char>&
 
 uint32_t DiceHandler(std::vector<unsigned char>& betInfo, uint256 seed);
 
+void DiceBatchHandler(const std::vector<const std::vector<unsigned char>*>& vBetInfos, uint256 seed, std::vector<uint32_t>& vOdds);
+
 std::string DiceGameTypeToStr(QuickGamesDiceBetType type);
 QuickGamesDiceBetType StrToDiceGameType(std::string strType);
 
@@ -18,6 +18,12 @@ typedef enum QuickGamesType {
  */
 typedef uint32_t (*const BetHandler)(std::vector<unsigned char>& betInfo, uint256 seed);
 
+/* The quick game batch handler prototype, handles all bets
+ * of a block with the seed of the block at once
+ * and fills the odds factors in order of the bets.
+ */
+typedef void (*const BetBatchHandler)(const std::vector<const std::vector<unsigned char>*>& vBetInfos, uint256 seed, std::vector<uint32_t>& vOdds);
+
 /*
  * The quick game bet info parser for RPC
  * Ret value is KV map with paramName: paramValue
@@ -31,6 +37,7 @@ public:
     const std::string name;
     const QuickGamesType type;
     const BetHandler handler;
+    const BetBatchHandler batchHandler;
     const BetInfoParser betInfoParser;
     const std::string specialAddress;
     const uint32_t nFeePermille = 10; // 1%
@@ -38,11 +45,11 @@ public:
     const uint32_t nDevRewardPermille;
 
     explicit CQuickGamesView() = delete;
-    explicit CQuickGamesView(const std::string name, const QuickGamesType type, BetHandler handler, BetInfoParser betInfoParser, const std::string specialAddress, const uint32_t nOMNORewardPermille, const uint32_t nDevRewardPermille) :
-            name(name), type(type), handler(handler), betInfoParser(betInfoParser), specialAddress(specialAddress), nOMNORewardPermille(nOMNORewardPermille), nDevRewardPermille(nDevRewardPermille) { }
+    explicit CQuickGamesView(const std::string name, const QuickGamesType type, BetHandler handler, BetBatchHandler batchHandler, BetInfoParser betInfoParser, const std::string specialAddress, const uint32_t nOMNORewardPermille, const uint32_t nDevRewardPermille) :
+            name(name), type(type), handler(handler), batchHandler(batchHandler), betInfoParser(betInfoParser), specialAddress(specialAddress), nOMNORewardPermille(nOMNORewardPermille), nDevRewardPermille(nDevRewardPermille) { }
     // move constructor
     explicit CQuickGamesView(const CQuickGamesView&& view) :
-            name(view.name), type(view.type), handler(view.handler), betInfoParser(view.betInfoParser), specialAddress(view.specialAddress), nFeePermille(view.nFeePermille), nOMNORewardPermille(view.nOMNORewardPermille),  nDevRewardPermille(view.nDevRewardPermille) { }
+            name(view.name), type(view.type), handler(view.handler), batchHandler(view.batchHandler), betInfoParser(view.betInfoParser), specialAddress(view.specialAddress), nFeePermille(view.nFeePermille), nOMNORewardPermille(view.nOMNORewardPermille),  nDevRewardPermille(view.nDevRewardPermille) { }
     // copy constructor
     explicit CQuickGamesView(const CQuickGamesView& view) = delete;
 };
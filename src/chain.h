@@ -20,6 +20,7 @@
 #include "util.h"
 #include "libzerocoin/Denominations.h"
 
+#include <stdexcept>
 #include <vector>
 
 #include <boost/lexical_cast.hpp>
@@ -105,6 +106,93 @@ enum BlockStatus {
     BLOCK_FAILED_MASK = BLOCK_FAILED_VALID | BLOCK_FAILED_CHILD,
 };
 
+/** Number of mints of each zerocoin denomination, indexed like libzerocoin::zerocoinDenomList.
+ * Every block index carries one of these, so it is kept as a fixed array instead of a
+ * std::map with a heap node per denomination. It serializes exactly like the
+ * std::map<libzerocoin::CoinDenomination, int16_t> it replaces.
+ */
+class CZerocoinSupply
+{
+private:
+    static const size_t DENOMS_COUNT = 8;
+    int16_t vSupply[DENOMS_COUNT];
+
+    static int DenomIndex(libzerocoin::CoinDenomination denom)
+    {
+        switch (denom) {
+        case libzerocoin::ZQ_ONE: return 0;
+        case libzerocoin::ZQ_FIVE: return 1;
+        case libzerocoin::ZQ_TEN: return 2;
+        case libzerocoin::ZQ_FIFTY: return 3;
+        case libzerocoin::ZQ_ONE_HUNDRED: return 4;
+        case libzerocoin::ZQ_FIVE_HUNDRED: return 5;
+        case libzerocoin::ZQ_ONE_THOUSAND: return 6;
+        case libzerocoin::ZQ_FIVE_THOUSAND: return 7;
+        default: return -1;
+        }
+    }
+
+public:
+    CZerocoinSupply()
+    {
+        SetNull();
+    }
+
+    void SetNull()
+    {
+        for (size_t i = 0; i < DENOMS_COUNT; i++)
+            vSupply[i] = 0;
+    }
+
+    //! Throws std::out_of_range for an invalid denomination, like std::map::at
+    int16_t& at(libzerocoin::CoinDenomination denom)
+    {
+        int idx = DenomIndex(denom);
+        if (idx < 0)
+            throw std::out_of_range("CZerocoinSupply::at : invalid denomination");
+        return vSupply[idx];
+    }
+
+    const int16_t& at(libzerocoin::CoinDenomination denom) const
+    {
+        return const_cast<CZerocoinSupply*>(this)->at(denom);
+    }
+
+    unsigned int GetSerializeSize(int nType, int nVersion) const
+    {
+        unsigned int nSize = GetSizeOfCompactSize(DENOMS_COUNT);
+        for (auto& denom : libzerocoin::zerocoinDenomList)
+            nSize += ::GetSerializeSize(denom, nType, nVersion) + ::GetSerializeSize(at(denom), nType, nVersion);
+        return nSize;
+    }
+
+    template <typename Stream>
+    void Serialize(Stream& s, int nType, int nVersion) const
+    {
+        WriteCompactSize(s, DENOMS_COUNT);
+        for (auto& denom : libzerocoin::zerocoinDenomList) {
+            ::Serialize(s, denom, nType, nVersion);
+            ::Serialize(s, at(denom), nType, nVersion);
+        }
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s, int nType, int nVersion)
+    {
+        SetNull();
+        unsigned int nSize = ReadCompactSize(s);
+        for (unsigned int i = 0; i < nSize; i++) {
+            libzerocoin::CoinDenomination denom;
+            int16_t nSupply;
+            ::Unserialize(s, denom, nType, nVersion);
+            ::Unserialize(s, nSupply, nType, nVersion);
+            // an unknown denomination never has a supply to track
+            if (DenomIndex(denom) >= 0)
+                at(denom) = nSupply;
+        }
+    }
+};
+
 /** The block chain is a tree shaped structure starting with the
  * genesis block at the root, with each block potentially having multiple
  * candidates to be the next block. A blockindex may have multiple pprev pointing
@@ -186,7 +274,7 @@ public:
     uint32_t nSequenceId;
 
     //! zerocoin specific fields
-    std::map<libzerocoin::CoinDenomination, int16_t> mapZerocoinSupply;
+    CZerocoinSupply zerocoinSupply;
     std::vector<libzerocoin::CoinDenomination> vMintDenominationsInBlock;
 
     void SetNull()
@@ -220,9 +308,7 @@ public:
         nNonce = 0;
         nAccumulatorCheckpoint = 0;
         // Start supply of each denomination with 0s
-        for (auto& denom : libzerocoin::zerocoinDenomList) {
-            mapZerocoinSupply.insert(std::make_pair(denom, 0));
-        }
+        zerocoinSupply.SetNull();
         vMintDenominationsInBlock.clear();
     }
 
@@ -301,7 +387,7 @@ public:
      */
     int16_t GetZcMints(libzerocoin::CoinDenomination denom) const
     {
-        return mapZerocoinSupply.at(denom);
+        return zerocoinSupply.at(denom);
     }
 
     /**
@@ -524,7 +610,7 @@ public:
         READWRITE(nNonce);
         if(this->nVersion > 3) {
             READWRITE(nAccumulatorCheckpoint);
-            READWRITE(mapZerocoinSupply);
+            READWRITE(zerocoinSupply);
             READWRITE(vMintDenominationsInBlock);
         }
 
@@ -28,6 +28,16 @@ struct SeedSpec6 {
 
 #include "chainparamsseeds.h"
 
+void CChainParams::InitOracleKeys()
+{
+    mapOracleKeys.clear();
+    for (COracle& oracle : vOracles) {
+        bool fValidAddress = oracle.InitKeyID(*this);
+        assert(fValidAddress);
+        mapOracleKeys.emplace(oracle.getKeyID(), oracle);
+    }
+}
+
 /**
  * Main network
  */
@@ -274,6 +284,7 @@ public:
             std::string("Dice"), // Game name
             QuickGamesType::qgDice, // game type
             &quickgames::DiceHandler, // game bet handler
+            &quickgames::DiceBatchHandler, // game bets of block handler
             &quickgames::DiceBetInfoParser, // bet info parser
             std::string("Wm5om9hBJTyKqv5FkMSfZ2FDMeGp12fkTe"), // Dev address
             400, // OMNO reward permille (40%)
@@ -359,6 +370,8 @@ public:
 
         nBudget_Fee_Confirmations = 6; // Number of confirmations for the finalization fee
         nProposalEstablishmentTime = 60 * 60 * 24; // Proposals must be at least a day old to make it into a budget
+
+        InitOracleKeys();
     }
 
     const Checkpoints::CCheckpointData& Checkpoints() const
@@ -467,6 +480,7 @@ public:
             std::string("Dice"), // Game name
             QuickGamesType::qgDice, // game type
             &quickgames::DiceHandler, // game bet handler
+            &quickgames::DiceBatchHandler, // game bets of block handler
             &quickgames::DiceBetInfoParser, // bet info parser
             std::string("TLceyDrdPLBu8DK6UZjKu4vCDUQBGPybcY"), // Dev address
             400, // OMNO reward permille (40%)
@@ -518,6 +532,8 @@ public:
         nBudget_Fee_Confirmations = 3; // Number of confirmations for the finalization fee. We have to make this very short
                                        // here because we only have a 8 block finalization window on testnet
         nProposalEstablishmentTime = 60 * 5; // Proposals must be at least 5 mns old to make it into a test budget
+
+        InitOracleKeys();
     }
     const Checkpoints::CCheckpointData& Checkpoints() const
     {
@@ -627,6 +643,7 @@ public:
             std::string("Dice"), // Game name
             QuickGamesType::qgDice, // game type
             &quickgames::DiceHandler, // game bet handler
+            &quickgames::DiceBatchHandler, // game bets of block handler
             &quickgames::DiceBetInfoParser, // bet info parser
             std::string("TLuTVND9QbZURHmtuqD5ESECrGuB9jLZTs"), // Dev address
             400, // OMNO reward permille (40%)
@@ -654,6 +671,7 @@ public:
         fSkipProofOfWorkCheck = true;
         fTestnetToBeDeprecatedFieldRPC = false;
 
+        InitOracleKeys();
     }
     const Checkpoints::CCheckpointData& Checkpoints() const
     {
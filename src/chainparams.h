@@ -169,7 +169,8 @@ public:
     int Zerocoin_AccumulationStartHeight() const { return nZerocoinAccumulationStartHeight; }
 
     /** Betting on blockchain **/
-    std::vector<COracle> Oracles() const { return vOracles; }
+    const std::vector<COracle>& Oracles() const { return vOracles; }
+    const OracleKeyMap& OracleKeys() const { return mapOracleKeys; }
     int BetBlocksIndexTimespanV2() const { return nBetBlocksIndexTimespanV2; }
     int BetBlocksIndexTimespanV3() const { return nBetBlocksIndexTimespanV3; }
     uint64_t OMNORewardPermille() const { return nOMNORewardPermille; }
@@ -193,6 +194,9 @@ public:
 protected:
     CChainParams() {}
 
+    /** Index the oracle addresses by key id, must be called whenever vOracles is set */
+    void InitOracleKeys();
+
     uint256 hashGenesisBlock;
     MessageStartChars pchMessageStart;
     //! Raw pub key bytes for the broadcast alert signing key.
@@ -283,6 +287,7 @@ protected:
     int nZerocoinAccumulationStartHeight;
 
     std::vector<COracle> vOracles;
+    OracleKeyMap mapOracleKeys;
 
     int nBetBlocksIndexTimespanV2;
     int nBetBlocksIndexTimespanV3;
@@ -6,6 +6,8 @@
 #define FLUSHABLE_STORAGE_H
 
 #include <util.h>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include "leveldbwrapper.h"
 #include <boost/optional.hpp>
@@ -14,6 +16,98 @@ extern CCriticalSection cs_bettingdb;
 
 using MapKV = std::map<std::vector<unsigned char>, boost::optional<std::vector<unsigned char>>>;
 
+// Non-owning view of raw key or value bytes, valid while the owner is not changed
+class CStorageKVSlice {
+public:
+    CStorageKVSlice() : pbegin{nullptr}, nSize{0} { }
+    CStorageKVSlice(const unsigned char* pbegin, size_t nSize) : pbegin{pbegin}, nSize{nSize} { }
+    CStorageKVSlice(const std::vector<unsigned char>& v) : pbegin{v.data()}, nSize{v.size()} { }
+
+    const unsigned char* data() const { return pbegin; }
+    size_t size() const { return nSize; }
+    bool empty() const { return nSize == 0; }
+    const unsigned char* begin() const { return pbegin; }
+    const unsigned char* end() const { return pbegin + nSize; }
+
+    std::vector<unsigned char> ToVector() const { return std::vector<unsigned char>(begin(), end()); }
+
+    // same ordering as std::vector<unsigned char> comparison
+    int Compare(const CStorageKVSlice& other) const {
+        const size_t nMinSize = std::min(nSize, other.nSize);
+        int r = nMinSize ? memcmp(pbegin, other.pbegin, nMinSize) : 0;
+        if (r == 0) {
+            if (nSize < other.nSize) r = -1;
+            else if (nSize > other.nSize) r = 1;
+        }
+        return r;
+    }
+    friend bool operator==(const CStorageKVSlice& a, const CStorageKVSlice& b) { return a.Compare(b) == 0; }
+    friend bool operator!=(const CStorageKVSlice& a, const CStorageKVSlice& b) { return a.Compare(b) != 0; }
+    friend bool operator<(const CStorageKVSlice& a, const CStorageKVSlice& b) { return a.Compare(b) < 0; }
+    friend bool operator>(const CStorageKVSlice& a, const CStorageKVSlice& b) { return a.Compare(b) > 0; }
+
+private:
+    const unsigned char* pbegin;
+    size_t nSize;
+};
+
+// Deserialization stream reading directly from a slice, without copying it
+class CStorageKVSliceReader {
+public:
+    int nType;
+    int nVersion;
+
+    CStorageKVSliceReader(const CStorageKVSlice& slice, int nTypeIn, int nVersionIn) :
+        nType{nTypeIn}, nVersion{nVersionIn}, pcur{slice.begin()}, pend{slice.end()} { }
+
+    CStorageKVSliceReader& read(char* pch, size_t nSize) {
+        if (nSize > size()) {
+            throw std::ios_base::failure("CStorageKVSliceReader::read() : end of data");
+        }
+        memcpy(pch, pcur, nSize);
+        pcur += nSize;
+        return *this;
+    }
+
+    template <typename T>
+    CStorageKVSliceReader& operator>>(T& obj) {
+        ::Unserialize(*this, obj, nType, nVersion);
+        return *this;
+    }
+
+    const unsigned char* data() const { return pcur; }
+    size_t size() const { return pend - pcur; }
+    bool empty() const { return pcur == pend; }
+
+private:
+    const unsigned char* pcur;
+    const unsigned char* pend;
+};
+
+// Serialization stream appending to a byte vector
+class CStorageKVWriter {
+public:
+    int nType;
+    int nVersion;
+
+    CStorageKVWriter(std::vector<unsigned char>& vchData, int nTypeIn, int nVersionIn) :
+        nType{nTypeIn}, nVersion{nVersionIn}, vchData(vchData) { }
+
+    CStorageKVWriter& write(const char* pch, size_t nSize) {
+        vchData.insert(vchData.end(), pch, pch + nSize);
+        return *this;
+    }
+
+    template <typename T>
+    CStorageKVWriter& operator<<(const T& obj) {
+        ::Serialize(*this, obj, nType, nVersion);
+        return *this;
+    }
+
+private:
+    std::vector<unsigned char>& vchData;
+};
+
 // Key-Value storage iterator interface
 class CStorageKVIterator {
 public:
@@ -24,8 +118,11 @@ public:
     virtual void Prev() = 0;
     virtual void Next() = 0;
     virtual bool Valid() = 0;
-    virtual std::vector<unsigned char> Key() = 0;
-    virtual std::vector<unsigned char> Value() = 0;
+    // views of the current entry, invalidated by the next move of the iterator
+    virtual CStorageKVSlice KeySlice() = 0;
+    virtual CStorageKVSlice ValueSlice() = 0;
+    std::vector<unsigned char> Key() { return KeySlice().ToVector(); }
+    std::vector<unsigned char> Value() { return ValueSlice().ToVector(); }
 };
 
 // Key-Value storage interface
@@ -37,6 +134,20 @@ public:
     virtual bool Erase(const std::vector<unsigned char>& key) = 0;
     virtual bool Read(const std::vector<unsigned char>& key, std::vector<unsigned char>& value) = 0;
     virtual std::unique_ptr<CStorageKVIterator> NewIterator() = 0;
+    // Apply a set of changes (none values are erasures), storages with native batches commit them at once
+    virtual bool WriteBatch(const MapKV& changes) {
+        for (auto it = changes.begin(); it != changes.end(); it++) {
+            if (!it->second) {
+                if (!Erase(it->first))
+                    return false;
+            }
+            else {
+                if (!Write(it->first, it->second.get()))
+                    return false;
+            }
+        }
+        return true;
+    }
 };
 
 // LevelDB glue layer Iterator
@@ -56,10 +167,10 @@ public:
     void Prev() override { it->Prev(); }
     void Next() override { it->Next(); }
     bool Valid() override { return it->Valid(); }
-    std::vector<unsigned char> Key() override {
+    CStorageKVSlice KeySlice() override {
         return ExtractSlice(it->key());
     }
-    std::vector<unsigned char> Value() override {
+    CStorageKVSlice ValueSlice() override {
         return ExtractSlice(it->value());
     }
 private:
@@ -68,11 +179,14 @@ private:
     CStorageLevelDBIterator(const CStorageLevelDBIterator&);
     void operator=(const CStorageLevelDBIterator&);
 
-    std::vector<unsigned char> ExtractSlice(const leveldb::Slice& s) {
-        std::vector<unsigned char> v;
-        CDataStream stream(s.data(), s.data() + s.size(), SER_DISK, CLIENT_VERSION);
-        stream >> v;
-        return v;
+    // entries are stored as serialized byte vectors, skip the size prefix
+    CStorageKVSlice ExtractSlice(const leveldb::Slice& s) {
+        CStorageKVSliceReader reader(CStorageKVSlice((const unsigned char*)s.data(), s.size()), SER_DISK, CLIENT_VERSION);
+        uint64_t nSize = ReadCompactSize(reader);
+        if (nSize > reader.size()) {
+            throw std::ios_base::failure("CStorageLevelDBIterator::ExtractSlice() : end of data");
+        }
+        return CStorageKVSlice(reader.data(), nSize);
     }
 };
 
@@ -88,6 +202,20 @@ public:
     std::unique_ptr<CStorageKVIterator> NewIterator() override {
         return MakeUnique<CStorageLevelDBIterator>(std::unique_ptr<leveldb::Iterator>(db.NewIterator()));
     }
+    // one leveldb write batch and a single sync instead of a synced write per key
+    bool WriteBatch(const MapKV& changes) override {
+        if (changes.empty()) return true;
+        CLevelDBBatch batch;
+        for (auto it = changes.begin(); it != changes.end(); it++) {
+            if (!it->second) {
+                batch.Erase(it->first);
+            }
+            else {
+                batch.Write(it->first, it->second.get());
+            }
+        }
+        return db.WriteBatch(batch, true);
+    }
 private:
     CLevelDBWrapper db;
 };
@@ -148,7 +276,7 @@ public:
 
         while (reverseOk || parentOk) {
             if (reverseOk) {
-                while (reverseOk && (!parentOk || rIt->first >= pIt->Key())) {
+                while (reverseOk && (!parentOk || !(CStorageKVSlice(rIt->first) < pIt->KeySlice()))) {
                     bool ok = false;
 
                     if (rIt->second) {
@@ -157,8 +285,7 @@ public:
                         prevKey = rIt->first;
                     }
                     if (ok) {
-                        key = rIt->first, value = *rIt->second;
-                        prevKey = rIt->first;
+                        SetCurrent(rIt->first, *rIt->second);
                     }
                     if (reverseOk) {
                         ++rIt;
@@ -168,11 +295,10 @@ public:
                 }
             }
             if (parentOk) {
-                bool ok = prevKey.empty() || pIt->Key() < prevKey;
+                CStorageKVSlice parentKey = pIt->KeySlice();
+                bool ok = prevKey.empty() || parentKey < prevKey;
                 if (ok) {
-                    key = pIt->Key();
-                    value = pIt->Value();
-                    prevKey = key;
+                    SetCurrent(parentKey, pIt->ValueSlice());
                 }
                 if (parentOk) {
                     pIt->Prev();
@@ -189,7 +315,7 @@ public:
 
         while (mapOk || parentOk) {
             if (mapOk) {
-                while (mapOk && (!parentOk || mIt->first <= pIt->Key())) {
+                while (mapOk && (!parentOk || !(CStorageKVSlice(mIt->first) > pIt->KeySlice()))) {
                     bool ok = false;
 
                     if (mIt->second) {
@@ -199,8 +325,7 @@ public:
                         prevKey = mIt->first;
                     }
                     if (ok) {
-                        key = mIt->first, value = *mIt->second;
-                        prevKey = mIt->first;
+                        SetCurrent(mIt->first, *mIt->second);
                     }
                     if (mapOk) {
                         mIt++;
@@ -210,11 +335,10 @@ public:
                 }
             }
             if (parentOk) {
-                bool ok = prevKey.empty() || pIt->Key() > prevKey;
+                CStorageKVSlice parentKey = pIt->KeySlice();
+                bool ok = prevKey.empty() || parentKey > prevKey;
                 if (ok) {
-                    key = pIt->Key();
-                    value = pIt->Value();
-                    prevKey = key;
+                    SetCurrent(parentKey, pIt->ValueSlice());
                 }
                 if (parentOk) {
                     pIt->Next();
@@ -227,13 +351,20 @@ public:
     bool Valid() override {
         return !key.empty();
     }
-    std::vector<unsigned char> Key() override {
+    CStorageKVSlice KeySlice() override {
         return key;
     }
-    std::vector<unsigned char> Value() override {
+    CStorageKVSlice ValueSlice() override {
         return value;
     }
 private:
+    // copy the entry into buffers owned by the iterator, reusing their capacity
+    void SetCurrent(const CStorageKVSlice& keyIn, const CStorageKVSlice& valueIn) {
+        key.assign(keyIn.begin(), keyIn.end());
+        value.assign(valueIn.begin(), valueIn.end());
+        prevKey.assign(keyIn.begin(), keyIn.end());
+    }
+
     bool inited;
     std::unique_ptr<CStorageKVIterator> pIt;
     bool parentOk;
@@ -283,17 +414,15 @@ public:
             }
         }
     }
-    bool Flush() {
-        for (auto it = changed.begin(); it != changed.end(); it++) {
-            if (!it->second) {
-                if (!db.Erase(it->first))
-                    return false;
-            }
-            else {
-                if (!db.Write(it->first, it->second.get()))
-                    return false;
-            }
+    bool WriteBatch(const MapKV& changes) override {
+        for (auto it = changes.begin(); it != changes.end(); it++) {
+            changed[it->first] = it->second;
         }
+        return true;
+    }
+    bool Flush() {
+        if (!db.WriteBatch(changed))
+            return false;
         changed.clear();
         return true;
     }
@@ -303,6 +432,14 @@ public:
     unsigned int GetCacheSize() {
         return changed.size();
     }
+    const MapKV& GetRaw() const {
+        return changed;
+    }
+    MapKV TakeRaw() {
+        MapKV raw;
+        raw.swap(changed);
+        return raw;
+    }
     unsigned int GetCacheSizeBytesToWrite() {
         unsigned int sum = 0;
         for (auto it = changed.begin(); it != changed.end(); it++) {
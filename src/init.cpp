@@ -48,6 +48,7 @@
 #include "zwgr/accumulatorcheckpoints.h"
 #include "zwgrchain.h"
 #include <betting/bet_db.h>
+#include <betting/bet_v3.h>
 
 #ifdef ENABLE_WALLET
 #include "wallet/db.h"
@@ -416,6 +417,7 @@ std::string HelpMessage(HelpMessageMode mode)
 #if !defined(WIN32)
     strUsage += HelpMessageOpt("-sysperms", _("Create new files with system default permissions, instead of umask 077 (only effective with disabled wallet functionality)"));
 #endif
+    strUsage += HelpMessageOpt("-trustblockindex", strprintf(_("Take the block hashes from the block index keys instead of rehashing every header on startup (default: %u)"), DEFAULT_TRUST_BLOCK_INDEX));
     strUsage += HelpMessageOpt("-txindex", strprintf(_("Maintain a full transaction index, used by the getrawtransaction rpc call (default: %u)"), 0));
     strUsage += HelpMessageOpt("-forcestart", _("Attempt to force blockchain corruption recovery") + " " + _("on startup"));
 
@@ -1104,6 +1106,8 @@ bool AppInit2()
     if (nScriptCheckThreads) {
         for (int i = 0; i < nScriptCheckThreads - 1; i++)
             threadGroup.create_thread(&ThreadScriptCheck);
+        for (int i = 0; i < nScriptCheckThreads - 1; i++)
+            threadGroup.create_thread(&ThreadBetCheck);
     }
 
     if (mapArgs.count("-sporkkey")) // spork priv key
@@ -1430,7 +1434,7 @@ bool AppInit2()
     nTotalCache -= nBlockTreeDBCache;
     size_t nCoinDBCache = nTotalCache / 2; // use half of the remaining cache for coindb cache
     nTotalCache -= nCoinDBCache;
-    nCoinCacheSize = nTotalCache / 300; // coins in memory require around 300 bytes
+    nCoinCacheUsage = nTotalCache; // the rest goes to the in-memory coins cache
 
     bool fLoaded = false;
     while (!fLoaded && !ShutdownRequested()) {
@@ -1478,15 +1482,30 @@ bool AppInit2()
                 bettingsView->eventsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("events"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
                 bettingsView->events = MakeUnique<CBettingDB>(*bettingsView->eventsStorage.get());
 
+                bettingsView->eventStartTimesStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("eventstarttimes"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
+                bettingsView->eventStartTimes = MakeUnique<CBettingDB>(*bettingsView->eventStartTimesStorage.get());
+
                 bettingsView->resultsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("results"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
                 bettingsView->results = MakeUnique<CBettingDB>(*bettingsView->resultsStorage.get());
 
                 bettingsView->betsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("bets"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
                 bettingsView->bets = MakeUnique<CBettingDB>(*bettingsView->betsStorage.get());
 
+                bettingsView->eventBetsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("eventbets"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
+                bettingsView->eventBets = MakeUnique<CBettingDB>(*bettingsView->eventBetsStorage.get());
+
+                bettingsView->playerBetsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("playerbets"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
+                bettingsView->playerBets = MakeUnique<CBettingDB>(*bettingsView->playerBetsStorage.get());
+
+                bettingsView->bettingTxsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("bettingtxs"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
+                bettingsView->bettingTxs = MakeUnique<CBettingDB>(*bettingsView->bettingTxsStorage.get());
+
                 bettingsView->undosStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("undos"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
                 bettingsView->undos = MakeUnique<CBettingDB>(*bettingsView->undosStorage.get());
 
+                bettingsView->undoHeightsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("undoheights"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
+                bettingsView->undoHeights = MakeUnique<CBettingDB>(*bettingsView->undoHeightsStorage.get());
+
                 bettingsView->payoutsInfoStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("payoutsinfo"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
                 bettingsView->payoutsInfo = MakeUnique<CBettingDB>(*bettingsView->payoutsInfoStorage.get());
 
@@ -1502,9 +1521,20 @@ bool AppInit2()
                 bettingsView->chainGamesLottoResultsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("cglottoresults"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
                 bettingsView->chainGamesLottoResults = MakeUnique<CBettingDB>(*bettingsView->chainGamesLottoResultsStorage.get());
 
+                bettingsView->blockResultsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("blockresults"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
+                bettingsView->blockResults = MakeUnique<CBettingDB>(*bettingsView->blockResultsStorage.get());
+
+                bettingsView->completedBetsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("completedbets"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
+                bettingsView->completedBets = MakeUnique<CBettingDB>(*bettingsView->completedBetsStorage.get());
+
+                bettingsView->parlayLegsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("parlaylegs"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
+                bettingsView->parlayLegs = MakeUnique<CBettingDB>(*bettingsView->parlayLegsStorage.get());
+
                 bettingsView->failedBettingTxsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("failedtxs"), CBettingDB::dbWrapperCacheSize(), false, fReindex);
                 bettingsView->failedBettingTxs = MakeUnique<CBettingDB>(*bettingsView->failedBettingTxsStorage.get());
 
+                bettingsView->LoadMappingNames();
+
                 if (fReindex)
                     pblocktree->WriteReindexing(true);
 
@@ -1535,6 +1565,20 @@ bool AppInit2()
                     break;
                 }
 
+                // Rebuild secondary betting indexes if blocks were connected by older versions.
+                // The betting DBs are checked against the block at their own last height,
+                // they are flushed apart from the chainstate.
+                CBlockIndex* pindexBetting = chainActive[bettingsView->GetLastHeight()];
+                uint256 hashBettingBlock = pindexBetting ? pindexBetting->GetBlockHash() : uint256(0);
+                if (!bettingsView->IndexesSynced(hashBettingBlock)) {
+                    uiInterface.InitMessage(_("Rebuilding betting indexes..."));
+                    bettingsView->RebuildIndexes(hashBettingBlock);
+                }
+                bettingsView->LoadUpcomingEvents(GetTime());
+                bettingsView->InitBlockResults();
+                bettingsView->InitCompletedBets();
+                bettingsView->InitParlayLegs();
+
                 // Check for changed -txindex state
                 if (fTxIndex != GetBoolArg("-txindex", true)) {
                     strLoadError = _("You need to rebuild the database using -reindex to change -txindex");
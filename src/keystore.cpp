@@ -62,6 +62,17 @@ bool CBasicKeyStore::GetCScript(const CScriptID& hash, CScript& redeemScriptOut)
     return false;
 }
 
+void CBasicKeyStore::GetCScripts(std::set<CScriptID>& setScriptIds) const
+{
+    setScriptIds.clear();
+    {
+        LOCK(cs_KeyStore);
+        for (const auto& script : mapScripts) {
+            setScriptIds.insert(script.first);
+        }
+    }
+}
+
 bool CBasicKeyStore::AddWatchOnly(const CScript& dest)
 {
     LOCK(cs_KeyStore);
@@ -88,6 +99,12 @@ bool CBasicKeyStore::HaveWatchOnly() const
     return (!setWatchOnly.empty());
 }
 
+void CBasicKeyStore::GetWatchOnly(WatchOnlySet& setWatchOnlyRet) const
+{
+    LOCK(cs_KeyStore);
+    setWatchOnlyRet = setWatchOnly;
+}
+
 bool CBasicKeyStore::AddMultiSig(const CScript& dest)
 {
     LOCK(cs_KeyStore);
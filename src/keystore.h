@@ -77,11 +77,13 @@ public:
     virtual bool AddCScript(const CScript& redeemScript);
     virtual bool HaveCScript(const CScriptID& hash) const;
     virtual bool GetCScript(const CScriptID& hash, CScript& redeemScriptOut) const;
+    void GetCScripts(std::set<CScriptID>& setScriptIds) const;
 
     virtual bool AddWatchOnly(const CScript& dest);
     virtual bool RemoveWatchOnly(const CScript& dest);
     virtual bool HaveWatchOnly(const CScript& dest) const;
     virtual bool HaveWatchOnly() const;
+    void GetWatchOnly(WatchOnlySet& setWatchOnlyRet) const;
 
     virtual bool AddMultiSig(const CScript& dest);
     virtual bool RemoveMultiSig(const CScript& dest);
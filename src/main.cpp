@@ -80,7 +80,7 @@ bool fTxIndex = true;
 bool fIsBareMultisigStd = true;
 bool fCheckBlockIndex = false;
 bool fVerifyingBlocks = false;
-unsigned int nCoinCacheSize = 5000;
+size_t nCoinCacheUsage = 5000 * 300;
 unsigned int nBettingCacheSize = 1000;
 bool fAlerts = DEFAULT_ALERTS;
 
@@ -1930,7 +1930,7 @@ bool WriteBlockToDisk(CBlock& block, CDiskBlockPos& pos)
     return true;
 }
 
-bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos)
+static bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos, uint256& hashBlock)
 {
     block.SetNull();
 
@@ -1947,20 +1947,29 @@ bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos)
     }
 
     // Check the header
+    hashBlock = block.GetHash();
     if (block.IsProofOfWork()) {
-        if (!CheckProofOfWork(block.GetHash(), block.nBits))
+        if (!CheckProofOfWork(hashBlock, block.nBits))
             return error("ReadBlockFromDisk : Errors in block header");
     }
 
     return true;
 }
 
+bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos)
+{
+    uint256 hashBlock;
+    return ReadBlockFromDisk(block, pos, hashBlock);
+}
+
 bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex)
 {
-    if (!ReadBlockFromDisk(block, pindex->GetBlockPos()))
+    // Reuse the hash computed for the header check instead of hashing the block again
+    uint256 hashBlock;
+    if (!ReadBlockFromDisk(block, pindex->GetBlockPos(), hashBlock))
         return false;
-    if (block.GetHash() != pindex->GetBlockHash()) {
-        LogPrintf("%s : block=%s index=%s\n", __func__, block.GetHash().GetHex(), pindex->GetBlockHash().GetHex());
+    if (hashBlock != pindex->GetBlockHash()) {
+        LogPrintf("%s : block=%s index=%s\n", __func__, hashBlock.GetHex(), pindex->GetBlockHash().GetHex());
         return error("ReadBlockFromDisk(CBlock&, CBlockIndex*) : GetHash() doesn't match index");
     }
     return true;
@@ -2524,7 +2533,7 @@ bool DisconnectBlock(CBlock& block, CValidationState& state, CBlockIndex* pindex
     // move best block pointer to prevout block
     view.SetBestBlock(pindex->pprev->GetBlockHash());
 
-    bettingsViewCache.SetLastHeight(pindex->pprev->nHeight);
+    bettingsViewCache.SetLastHeight(pindex->pprev->nHeight, pindex->pprev->GetBlockHash());
 
     if (!fVerifyingBlocks && pindex->nHeight <= Params().Zerocoin_Block_Last_Checkpoint()) {
         //if block is an accumulator checkpoint block, remove checkpoint and checksums from db
@@ -2592,7 +2601,7 @@ void AddWrappedSerialsInflation()
 
         // Add inflated denominations to block index mapSupply
         for (auto denom : libzerocoin::zerocoinDenomList) {
-            pindex->mapZerocoinSupply.at(denom) += GetWrapppedSerialInflation(denom);
+            pindex->zerocoinSupply.at(denom) += GetWrapppedSerialInflation(denom);
         }
         // Update current block index to disk
         assert(pblocktree->WriteBlockIndex(CDiskBlockIndex(pindex)));
@@ -2655,22 +2664,22 @@ void RecalculateZWGRSpent()
         std::list<libzerocoin::CoinDenomination> listDenomsSpent = ZerocoinSpendListFromBlock(block, true);
 
         //Reset the supply to previous block
-        pindex->mapZerocoinSupply = pindex->pprev->mapZerocoinSupply;
+        pindex->zerocoinSupply = pindex->pprev->zerocoinSupply;
 
         //Add mints to zWGR supply
         for (auto denom : libzerocoin::zerocoinDenomList) {
             long nDenomAdded = count(pindex->vMintDenominationsInBlock.begin(), pindex->vMintDenominationsInBlock.end(), denom);
-            pindex->mapZerocoinSupply.at(denom) += nDenomAdded;
+            pindex->zerocoinSupply.at(denom) += nDenomAdded;
         }
 
         //Remove spends from zWGR supply
         for (auto denom : listDenomsSpent)
-            pindex->mapZerocoinSupply.at(denom)--;
+            pindex->zerocoinSupply.at(denom)--;
 
         // Add inflation from Wrapped Serials if block is Zerocoin_Block_EndFakeSerial()
         if (pindex->nHeight == Params().Zerocoin_Block_EndFakeSerial() + 1)
             for (auto denom : libzerocoin::zerocoinDenomList) {
-                pindex->mapZerocoinSupply.at(denom) += GetWrapppedSerialInflation(denom);
+                pindex->zerocoinSupply.at(denom) += GetWrapppedSerialInflation(denom);
             }
 
         //Rewrite money supply
@@ -2812,7 +2821,7 @@ bool UpdateZWGRSupply(const CBlock& block, CBlockIndex* pindex, bool fJustCheck)
     // Initialize zerocoin supply to the supply from previous block
     if (pindex->pprev && pindex->pprev->GetBlockHeader().nVersion > 3) {
         for (auto& denom : libzerocoin::zerocoinDenomList) {
-            pindex->mapZerocoinSupply.at(denom) = pindex->pprev->GetZcMints(denom);
+            pindex->zerocoinSupply.at(denom) = pindex->pprev->GetZcMints(denom);
         }
     }
 
@@ -2824,7 +2833,7 @@ bool UpdateZWGRSupply(const CBlock& block, CBlockIndex* pindex, bool fJustCheck)
         for (auto& m : listMints) {
             libzerocoin::CoinDenomination denom = m.GetDenomination();
             pindex->vMintDenominationsInBlock.push_back(m.GetDenomination());
-            pindex->mapZerocoinSupply.at(denom)++;
+            pindex->zerocoinSupply.at(denom)++;
 
             //Remove any of our own mints from the mintpool
             if (!fJustCheck && pwalletMain) {
@@ -2849,7 +2858,7 @@ bool UpdateZWGRSupply(const CBlock& block, CBlockIndex* pindex, bool fJustCheck)
         }
 
         for (auto& denom : listSpends) {
-            pindex->mapZerocoinSupply.at(denom)--;
+            pindex->zerocoinSupply.at(denom)--;
             nAmountZerocoinSpent += libzerocoin::ZerocoinDenominationToAmount(denom);
 
             // zerocoin failsafe
@@ -2859,14 +2868,14 @@ bool UpdateZWGRSupply(const CBlock& block, CBlockIndex* pindex, bool fJustCheck)
     }
 
     for (auto& denom : libzerocoin::zerocoinDenomList)
-        LogPrint("zero", "%s coins for denomination %d pubcoin %s\n", __func__, denom, pindex->mapZerocoinSupply.at(denom));
+        LogPrint("zero", "%s coins for denomination %d pubcoin %s\n", __func__, denom, pindex->zerocoinSupply.at(denom));
 
     // Update Wrapped Serials amount
     // A one-time event where only the zWGR supply was off (due to serial duplication off-chain on main net)
     if (Params().NetworkID() == CBaseChainParams::MAIN && pindex->nHeight == Params().Zerocoin_Block_EndFakeSerial() + 1
             && pindex->GetZerocoinSupply() < Params().GetSupplyBeforeFakeSerial() + GetWrapppedSerialInflationAmount()) {
         for (auto denom : libzerocoin::zerocoinDenomList) {
-            pindex->mapZerocoinSupply.at(denom) += GetWrapppedSerialInflation(denom);
+            pindex->zerocoinSupply.at(denom) += GetWrapppedSerialInflation(denom);
         }
     }
     return true;
@@ -2906,9 +2915,10 @@ bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pin
 
     // Special case for the genesis block, skipping connection of its transactions
     // (its coinbase is unspendable)
-    if (block.GetHash() == Params().HashGenesisBlock()) {
+    uint256 hashBlock = block.GetHash();
+    if (hashBlock == Params().HashGenesisBlock()) {
         view.SetBestBlock(pindex->GetBlockHash());
-        bettingsViewCache.SetLastHeight(pindex->nHeight);
+        bettingsViewCache.SetLastHeight(pindex->nHeight, pindex->GetBlockHash());
         return true;
     }
 
@@ -2946,7 +2956,6 @@ bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pin
     CAmount nValueBurned = 0;
     unsigned int nMaxBlockSigOps = MAX_BLOCK_SIGOPS_CURRENT;
     std::vector<uint256> vSpendsInBlock;
-    uint256 hashBlock = block.GetHash();
     for (unsigned int i = 0; i < block.vtx.size(); i++) {
         const CTransaction& tx = block.vtx[i];
 
@@ -3260,9 +3269,10 @@ bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pin
         if (!(pindex->nHeight % Params().MaxReorganizationDepth())) {
             int heightLimit = pindex->nHeight - Params().MaxBettingUndoDepth();
             bettingsViewCache.PruneOlderUndos((uint32_t)heightLimit);
+            bettingsViewCache.PruneOlderCompletedBets((uint32_t)heightLimit);
         }
     }
-    bettingsViewCache.SetLastHeight(pindex->nHeight);
+    bettingsViewCache.SetLastHeight(pindex->nHeight, pindex->GetBlockHash());
 
     return true;
 }
@@ -3284,7 +3294,7 @@ bool static FlushStateToDisk(CValidationState& state, FlushStateMode mode)
     static int64_t nLastWrite = 0;
     try {
         if ((mode == FLUSH_STATE_ALWAYS) ||
-            ((mode == FLUSH_STATE_PERIODIC || mode == FLUSH_STATE_IF_NEEDED) && pcoinsTip->GetCacheSize() > nCoinCacheSize) ||
+            ((mode == FLUSH_STATE_PERIODIC || mode == FLUSH_STATE_IF_NEEDED) && pcoinsTip->DynamicMemoryUsage() > nCoinCacheUsage) ||
             ((mode == FLUSH_STATE_PERIODIC || mode == FLUSH_STATE_IF_NEEDED) && bettingsView->GetCacheSize() > nBettingCacheSize) ||
             (mode == FLUSH_STATE_PERIODIC && GetTimeMicros() > nLastWrite + DATABASE_WRITE_INTERVAL * 1000000)) {
             // Typical CCoins structures on disk are around 100 bytes in size.
@@ -3793,6 +3803,7 @@ bool ActivateBestChain(CValidationState& state, CBlock* pblock, bool fAlreadyChe
 {
     CBlockIndex* pindexNewTip = NULL;
     CBlockIndex* pindexMostWork = NULL;
+    const uint256 hashBlock = pblock ? pblock->GetHash() : uint256(0);
     do {
         boost::this_thread::interruption_point();
 
@@ -3810,7 +3821,7 @@ bool ActivateBestChain(CValidationState& state, CBlock* pblock, bool fAlreadyChe
             if (pindexMostWork == NULL || pindexMostWork == chainActive.Tip())
                 return true;
 
-            if (!ActivateBestChainStep(state, pindexMostWork, pblock && pblock->GetHash() == pindexMostWork->GetBlockHash() ? pblock : NULL, fAlreadyChecked))
+            if (!ActivateBestChainStep(state, pindexMostWork, pblock && hashBlock == pindexMostWork->GetBlockHash() ? pblock : NULL, fAlreadyChecked))
                 return false;
 
             pindexNewTip = chainActive.Tip();
@@ -4142,7 +4153,9 @@ bool CheckBlock(const CBlock& block, CValidationState& state, bool fCheckPOW, bo
 {
     // These are checks that are independent of context.
     const bool IsPoS = block.IsProofOfStake();
-    LogPrint("debug", "%s: block=%s  is proof of stake=%d\n", __func__, block.GetHash().ToString().c_str(), IsPoS);
+    // LogPrint evaluates its arguments even when the category is off, so keep the hash out of the hot path
+    if (LogAcceptCategory("debug"))
+        LogPrint("debug", "%s: block=%s  is proof of stake=%d\n", __func__, block.GetHash().ToString().c_str(), IsPoS);
 
     if (block.fChecked)
         return true;
@@ -4492,7 +4505,7 @@ bool AcceptBlockHeader(const CBlock& block, CValidationState& state, CBlockIndex
                 }
             }
 
-            return state.DoS(100, error("%s : prev block height=%d hash=%s is invalid, unable to add block %s", __func__, pindexPrev->nHeight, block.hashPrevBlock.GetHex(), block.GetHash().GetHex()),
+            return state.DoS(100, error("%s : prev block height=%d hash=%s is invalid, unable to add block %s", __func__, pindexPrev->nHeight, block.hashPrevBlock.GetHex(), hash.GetHex()),
                              REJECT_INVALID, "bad-prevblk");
         }
 
@@ -4515,10 +4528,11 @@ bool AcceptBlock(CBlock& block, CValidationState& state, CBlockIndex** ppindex,
     AssertLockHeld(cs_main);
 
     CBlockIndex*& pindex = *ppindex;
+    const uint256 hash = block.GetHash();
 
     // Get prev block index
     CBlockIndex* pindexPrev = NULL;
-    if (block.GetHash() != Params().HashGenesisBlock()) {
+    if (hash != Params().HashGenesisBlock()) {
         BlockMap::iterator mi = mapBlockIndex.find(block.hashPrevBlock);
         if (mi == mapBlockIndex.end())
             return state.DoS(0, error("%s : prev block %s not found", __func__, block.hashPrevBlock.GetHex()), 0, "bad-prevblk");
@@ -4534,12 +4548,12 @@ bool AcceptBlock(CBlock& block, CValidationState& state, CBlockIndex** ppindex,
                     return true;
                 }
             }
-            return state.DoS(100, error("%s : prev block %s is invalid, unable to add block %s", __func__, block.hashPrevBlock.GetHex(), block.GetHash().GetHex()),
+            return state.DoS(100, error("%s : prev block %s is invalid, unable to add block %s", __func__, block.hashPrevBlock.GetHex(), hash.GetHex()),
                              REJECT_INVALID, "bad-prevblk");
         }
     }
 
-    if (block.GetHash() != Params().HashGenesisBlock() && !CheckWork(block, pindexPrev))
+    if (hash != Params().HashGenesisBlock() && !CheckWork(block, pindexPrev))
         return false;
 
     bool isPoS = false;
@@ -4554,7 +4568,6 @@ bool AcceptBlock(CBlock& block, CValidationState& state, CBlockIndex** ppindex,
         if (!stake)
             return error("%s: null stake ptr", __func__);
 
-        uint256 hash = block.GetHash();
         if(!mapProofOfStake.count(hash)) // add to mapProofOfStake
             mapProofOfStake.insert(std::make_pair(hash, hashProofOfStake));
     }
@@ -4874,7 +4887,8 @@ bool ProcessNewBlock(CValidationState& state, CNode* pfrom, CBlock* pblock, CDis
     if (!CheckBlockSignature(*pblock))
         return error("%s : bad proof-of-stake block signature", __func__);
 
-    if (pblock->GetHash() != Params().HashGenesisBlock() && pfrom != NULL) {
+    const uint256 hashBlock = pblock->GetHash();
+    if (hashBlock != Params().HashGenesisBlock() && pfrom != NULL) {
         //if we get this far, check if the prev block is our prev block, if not then request sync and return false
         BlockMap::iterator mi = mapBlockIndex.find(pblock->hashPrevBlock);
         if (mi == mapBlockIndex.end()) {
@@ -4886,9 +4900,9 @@ bool ProcessNewBlock(CValidationState& state, CNode* pfrom, CBlock* pblock, CDis
     {
         LOCK(cs_main);
 
-        MarkBlockAsReceived(pblock->GetHash());
+        MarkBlockAsReceived(hashBlock);
         if (!checked) {
-            return error ("%s : CheckBlock FAILED for block %s", __func__, pblock->GetHash().GetHex());
+            return error ("%s : CheckBlock FAILED for block %s", __func__, hashBlock.GetHex());
         }
 
         // Store to disk
@@ -5219,7 +5233,7 @@ bool CVerifyDB::VerifyDB(CCoinsView* coinsview, int nCheckLevel, int nCheckDepth
             }
         }
         // check level 3: check for inconsistencies during memory-only disconnect of tip blocks
-        if (nCheckLevel >= 3 && pindex == pindexState && (coins.GetCacheSize() + pcoinsTip->GetCacheSize()) <= nCoinCacheSize) {
+        if (nCheckLevel >= 3 && pindex == pindexState && (coins.DynamicMemoryUsage() + pcoinsTip->DynamicMemoryUsage()) <= nCoinCacheUsage) {
             bool fClean = true;
             if (!DisconnectBlock(block, state, pindex, coins, bettings, &fClean))
                 return error("VerifyDB() : *** irrecoverable inconsistency in block data at %d, hash=%s", pindex->nHeight, pindex->GetBlockHash().ToString());
@@ -6535,7 +6549,7 @@ bool static ProcessMessage(CNode* pfrom, std::string strCommand, CDataStream& vR
             pfrom->AddInventoryKnown(inv);
 
             CValidationState state;
-            if (!mapBlockIndex.count(block.GetHash())) {
+            if (!mapBlockIndex.count(hashBlock)) {
                 ProcessNewBlock(state, pfrom, &block);
                 int nDoS;
                 if(state.IsInvalid(nDoS)) {
@@ -6549,7 +6563,7 @@ bool static ProcessMessage(CNode* pfrom, std::string strCommand, CDataStream& vR
                 //disconnect this node if its old protocol version
                 pfrom->DisconnectOldProtocol(ActiveProtocol(), strCommand);
             } else {
-                LogPrint("net", "%s : Already processed block %s, skipping ProcessNewBlock()\n", __func__, block.GetHash().GetHex());
+                LogPrint("net", "%s : Already processed block %s, skipping ProcessNewBlock()\n", __func__, hashBlock.GetHex());
             }
         }
     }
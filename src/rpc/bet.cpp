@@ -53,30 +53,14 @@ UniValue getmappingid(const UniValue& params, bool fHelp)
         throw std::runtime_error("No mapping exist for the mapping index you provided.");
     }
 
-    bool mappingFound{false};
-
-    {
-        LOCK(cs_bettingdb);
-
-        // Check the map for the string name.
-        auto it = bettingsView->mappings->NewIterator();
-        MappingKey key;
-        for (it->Seek(CBettingDB::DbTypeToBytes(MappingKey{type, 0})); it->Valid() && (CBettingDB::BytesToDbType(it->Key(), key), key.nMType == type); it->Next()) {
-            CMappingDB mapping{};
-            CBettingDB::BytesToDbType(it->Value(), mapping);
-            LogPrintf("wagerr", "%s - mapping - it=[%d,%d] nId=[%d] nMType=[%s] [%s]\n", __func__, key.nMType, key.nId, key.nId, CMappingDB::ToTypeName(key.nMType), mapping.sName);
-            if (!mappingFound) {
-                if (mapping.sName == name) {
-                    mappings.push_back(Pair("mapping-id", (uint64_t) key.nId));
-                    mappings.push_back(Pair("exists", true));
-                    mappings.push_back(Pair("mapping-index", mIndex));
-                    mappingFound = true;
-                }
-            }
-        }
-    }
-    if (mappingFound)
+    // Check the map for the string name.
+    uint32_t id;
+    if (bettingsView->GetMappingId(type, name, id)) {
+        mappings.push_back(Pair("mapping-id", (uint64_t) id));
+        mappings.push_back(Pair("exists", true));
+        mappings.push_back(Pair("mapping-index", mIndex));
         result.push_back(mappings);
+    }
 
     return result;
 }
@@ -121,7 +105,7 @@ UniValue getmappingname(const UniValue& params, bool fHelp)
     }
 
     CMappingDB map{};
-    if (bettingsView->mappings->Read(MappingKey{type, id}, map)) {
+    if (bettingsView->ReadMapping(MappingKey{type, id}, map)) {
         mapping.push_back(Pair("mapping-type", CMappingDB::ToTypeName(type)));
         mapping.push_back(Pair("mapping-name", map.sName));
         mapping.push_back(Pair("exists", true));
@@ -153,28 +137,32 @@ std::string GetPayoutTypeStr(PayoutType type)
     }
 }
 
+UniValue CreatePayoutInfoObj(const std::pair<bool, CPayoutInfoDB>& info)
+{
+    UniValue retObj{UniValue::VOBJ};
+    if (info.first) { // if payout info was found - add info to array
+        const CPayoutInfoDB &payoutInfo = info.second;
+        UniValue infoObj{UniValue::VOBJ};
+
+        infoObj.push_back(Pair("payoutType", GetPayoutTypeStr(payoutInfo.payoutType)));
+        infoObj.push_back(Pair("betBlockHeight", (uint64_t) payoutInfo.betKey.blockHeight));
+        infoObj.push_back(Pair("betTxHash", payoutInfo.betKey.outPoint.hash.GetHex()));
+        infoObj.push_back(Pair("betTxOut", (uint64_t) payoutInfo.betKey.outPoint.n));
+        retObj.push_back(Pair("found", UniValue{true}));
+        retObj.push_back(Pair("payoutInfo", infoObj));
+    }
+    else {
+        retObj.push_back(Pair("found", UniValue{false}));
+        retObj.push_back(Pair("payoutInfo", UniValue{UniValue::VOBJ}));
+    }
+    return retObj;
+}
+
 UniValue CreatePayoutInfoResponse(const std::vector<std::pair<bool, CPayoutInfoDB>> vPayoutsInfo)
 {
     UniValue responseArr{UniValue::VARR};
     for (auto info : vPayoutsInfo) {
-        UniValue retObj{UniValue::VOBJ};
-        if (info.first) { // if payout info was found - add info to array
-            CPayoutInfoDB &payoutInfo = info.second;
-            UniValue infoObj{UniValue::VOBJ};
-
-            infoObj.push_back(Pair("payoutType", GetPayoutTypeStr(payoutInfo.payoutType)));
-            infoObj.push_back(Pair("betBlockHeight", (uint64_t) payoutInfo.betKey.blockHeight));
-            infoObj.push_back(Pair("betTxHash", payoutInfo.betKey.outPoint.hash.GetHex()));
-            infoObj.push_back(Pair("betTxOut", (uint64_t) payoutInfo.betKey.outPoint.n));
-            retObj.push_back(Pair("found", UniValue{true}));
-            retObj.push_back(Pair("payoutInfo", infoObj));
-        }
-        else {
-            retObj.push_back(Pair("found", UniValue{false}));
-            retObj.push_back(Pair("payoutInfo", UniValue{UniValue::VOBJ}));
-        }
-
-        responseArr.push_back(retObj);
+        responseArr.push_back(CreatePayoutInfoObj(info));
     }
     return responseArr;
 }
@@ -226,17 +214,12 @@ UniValue getpayoutinfo(const UniValue& params, bool fHelp)
         RPCTypeCheckObj(obj, boost::assign::map_list_of("txHash", UniValue::VSTR)("nOut", UniValue::VNUM));
         uint256 txHash = uint256(find_value(obj, "txHash").get_str());
         uint32_t nOut = find_value(obj, "nOut").get_int();
-        uint256 hashBlock;
-        CTransaction tx;
-        if (!GetTransaction(txHash, tx, hashBlock, true)) {
-            vPayoutsInfo.emplace_back(std::pair<bool, CPayoutInfoDB>{false, CPayoutInfoDB{}});
-            continue;
-        }
-        if (hashBlock == 0) { // uncomfirmed tx
+        uint32_t blockHeight;
+        // payout txs are indexed by txid when their block is connected
+        if (!bettingsView->GetBettingTxHeight(txHash, blockHeight)) {
             vPayoutsInfo.emplace_back(std::pair<bool, CPayoutInfoDB>{false, CPayoutInfoDB{}});
             continue;
         }
-        uint32_t blockHeight = mapBlockIndex.at(hashBlock)->nHeight;
 
         CPayoutInfoDB payoutInfo;
         // try to find payout info from db
@@ -261,11 +244,17 @@ UniValue getpayoutinfo(const UniValue& params, bool fHelp)
  */
 UniValue getpayoutinfosince(const UniValue& params, bool fHelp)
 {
-    if (fHelp || (params.size() > 1))
+    if (fHelp || (params.size() > 3))
         throw std::runtime_error(
                 "getpayoutinfosince\n"
                 "\nGet info for payouts in the specified block range.\n"
                 "1. Last blocks (numeric, optional) default = 10.\n"
+                "2. Max count (numeric, optional) Maximum number of returned payouts, default = 0 (no limit).\n"
+                "3. Cursor (object, optional) Payout after which the listing continues, usually the last payout of the previous call.\n"
+                "  {\n"
+                "    \"txHash\": hash (string) Payout transaction hash.\n"
+                "    \"nOut\": nOut (numeric) Payout transaction out number.\n"
+                "  }\n"
                 "\nResult:\n"
                 "[\n"
                 "  {\n"
@@ -277,34 +266,70 @@ UniValue getpayoutinfosince(const UniValue& params, bool fHelp)
                 "        \"betTxHash\": hash (string) Bet transaction hash.\n"
                 "        \"betOut\": nOut (numeric) Bet transaction out number.\n"
                 "      }\n"
+                "    \"payoutBlockHeight\": height (numeric) Payout block height.\n"
+                "    \"txHash\": hash (string) Payout transaction hash.\n"
+                "    \"nOut\": nOut (numeric) Payout transaction out number.\n"
                 "  }\n"
                 "]\n"
                 "\nExamples:\n" +
-                HelpExampleCli("getpayoutinfosince", "15") + HelpExampleRpc("getpayoutinfosince", "15"));
+                HelpExampleCli("getpayoutinfosince", "15") + HelpExampleRpc("getpayoutinfosince", "15") +
+                HelpExampleRpc("getpayoutinfosince", "15, 100, {\"txHash\": \"08746e1bdb6f4aebd7f1f3da25ac11e1cd3cacaf34cd2ad144e376b2e7f74d49\", \"nOut\": 3}"));
 
-    std::vector<std::pair<bool, CPayoutInfoDB>> vPayoutsInfo;
     uint32_t nLastBlocks = 10;
-    if (params.size() == 1) {
+    if (params.size() > 0) {
         nLastBlocks = params[0].get_int();
         if (nLastBlocks < 1)
             throw std::runtime_error("Invalid number of last blocks.");
     }
 
+    uint32_t nMaxCount = 0;
+    if (params.size() > 1) {
+        if (params[1].get_int() < 0)
+            throw std::runtime_error("Invalid max count.");
+        nMaxCount = params[1].get_int();
+    }
+
     int nCurrentHeight = chainActive.Height();
 
     uint32_t startBlockHeight = static_cast<uint32_t>(nCurrentHeight) - nLastBlocks + 1;
+    PayoutInfoKey startKey{startBlockHeight, COutPoint()};
+    bool fAfterStartKey = false;
+
+    // continue after the payout of the previous call
+    if (params.size() > 2) {
+        const UniValue obj = params[2].get_obj();
+        RPCTypeCheckObj(obj, boost::assign::map_list_of("txHash", UniValue::VSTR)("nOut", UniValue::VNUM));
+        uint256 txHash = uint256(find_value(obj, "txHash").get_str());
+        uint32_t nOut = find_value(obj, "nOut").get_int();
+        uint32_t blockHeight;
+        if (!bettingsView->GetBettingTxHeight(txHash, blockHeight))
+            throw std::runtime_error("Invalid cursor, unknown payout transaction.");
+        if (blockHeight >= startBlockHeight) {
+            startKey = PayoutInfoKey{blockHeight, COutPoint{txHash, nOut}};
+            fAfterStartKey = true;
+        }
+    }
 
+    UniValue responseArr{UniValue::VARR};
     {
         LOCK(cs_bettingdb);
 
         auto it = bettingsView->payoutsInfo->NewIterator();
-        for (it->Seek(CBettingDB::DbTypeToBytes(PayoutInfoKey{startBlockHeight, COutPoint()})); it->Valid(); it->Next()) {
+        for (it->Seek(CBettingDB::DbTypeToBytes(startKey)); it->Valid(); it->Next()) {
+            if (nMaxCount > 0 && responseArr.size() >= nMaxCount)
+                break;
             PayoutInfoKey key;
             CPayoutInfoDB payoutInfo;
-            CBettingDB::BytesToDbType(it->Key(), key);
-            CBettingDB::BytesToDbType(it->Value(), payoutInfo);
-            vPayoutsInfo.emplace_back(std::pair<bool, CPayoutInfoDB>{true, payoutInfo});
+            CBettingDB::BytesToDbType(it->KeySlice(), key);
+            if (fAfterStartKey && key == startKey)
+                continue;
+            CBettingDB::BytesToDbType(it->ValueSlice(), payoutInfo);
+            UniValue retObj = CreatePayoutInfoObj(std::pair<bool, CPayoutInfoDB>{true, payoutInfo});
+            retObj.push_back(Pair("payoutBlockHeight", (uint64_t) key.blockHeight));
+            retObj.push_back(Pair("txHash", key.outPoint.hash.GetHex()));
+            retObj.push_back(Pair("nOut", (uint64_t) key.outPoint.n));
+            responseArr.push_back(retObj);
         }
     }
-    return CreatePayoutInfoResponse(vPayoutsInfo);
+    return responseArr;
 }
\ No newline at end of file
@@ -196,6 +196,7 @@ static const CRPCConvertParam vRPCConvertParams[] =
         {"getpayoutinfo", 0},
         {"getpayoutinfosince", 0},
         {"getpayoutinfosince", 1},
+        {"getpayoutinfosince", 2},
     };
 
 class CRPCConvertTable
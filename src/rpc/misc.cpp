@@ -145,7 +145,7 @@ UniValue getinfo(const UniValue& params, bool fHelp)
     obj.push_back(Pair("moneysupply",ValueFromAmount(chainActive.Tip()->nMoneySupply)));
     UniValue zwgrObj(UniValue::VOBJ);
     for (auto denom : libzerocoin::zerocoinDenomList) {
-        zwgrObj.push_back(Pair(std::to_string(denom), ValueFromAmount((denom*COIN) * chainActive.Tip()->mapZerocoinSupply.at(denom))));
+        zwgrObj.push_back(Pair(std::to_string(denom), ValueFromAmount((denom*COIN) * chainActive.Tip()->zerocoinSupply.at(denom))));
     }
     zwgrObj.push_back(Pair("total", ValueFromAmount(chainActive.Tip()->GetZerocoinSupply())));
     obj.push_back(Pair("zWGRsupply", zwgrObj));
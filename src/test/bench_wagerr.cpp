@@ -0,0 +1,62 @@
+// Copyright (c) 2020 The Wagerr developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "test/bench_wagerr.h"
+
+#include "tinyformat.h"
+#include "utiltime.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> nBenchAllocs{0};
+
+// Replaced for the bench binary only, array and nothrow forms of the library call this one
+void* operator new(std::size_t size)
+{
+    nBenchAllocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+uint64_t GetBenchAllocCount()
+{
+    return nBenchAllocs.load(std::memory_order_relaxed);
+}
+
+void CBenchSection::Restart()
+{
+    nStartAllocs = GetBenchAllocCount();
+    nStartMicros = GetTimeMicros();
+}
+
+int64_t CBenchSection::ElapsedMicros() const
+{
+    return GetTimeMicros() - nStartMicros;
+}
+
+uint64_t CBenchSection::Allocations() const
+{
+    return GetBenchAllocCount() - nStartAllocs;
+}
+
+std::string CBenchSection::ToString() const
+{
+    // read the counter first, the string formatting allocates
+    const uint64_t nAllocs = Allocations();
+    const int64_t nMicros = ElapsedMicros();
+    return strprintf("%.3f ms, %u allocations", nMicros / 1000.0, nAllocs);
+}
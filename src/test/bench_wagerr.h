@@ -0,0 +1,34 @@
+// Copyright (c) 2020 The Wagerr developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef WAGERR_TEST_BENCH_WAGERR_H
+#define WAGERR_TEST_BENCH_WAGERR_H
+
+#include <stdint.h>
+#include <string>
+
+/** Number of heap allocations made so far, counted by operator new of the bench binary */
+uint64_t GetBenchAllocCount();
+
+/** Wall time and heap allocations of a benchmarked section, from construction or the last Restart() */
+class CBenchSection
+{
+public:
+    CBenchSection() { Restart(); }
+
+    void Restart();
+
+    int64_t ElapsedMicros() const;
+
+    uint64_t Allocations() const;
+
+    //! "<ms> ms, <n> allocations"
+    std::string ToString() const;
+
+private:
+    int64_t nStartMicros;
+    uint64_t nStartAllocs;
+};
+
+#endif // WAGERR_TEST_BENCH_WAGERR_H
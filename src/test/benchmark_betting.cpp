@@ -0,0 +1,318 @@
+// Copyright (c) 2020 The Wagerr developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "betting/bet.h"
+#include "betting/bet_db.h"
+#include "betting/bet_tx.h"
+#include "base58.h"
+#include "hash.h"
+#include "main.h"
+#include "random.h"
+#include "script/standard.h"
+#include "test/bench_wagerr.h"
+#include "test/test_wagerr.h"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+static constexpr uint32_t nBenchPayoutCount{10000};
+static constexpr uint32_t nBenchPlayerCount{250};
+static constexpr uint32_t nBenchCachedBetCount{100000};
+static constexpr uint32_t nBenchBetTxCount{5000};
+
+// Payouts of one popular event: many players, several winning bets per player
+static void BuildBlockPayouts(std::multimap<CPayoutInfoDB, CBetOut>& mExpectedPayouts, std::vector<CTxOut>& vFoundPayouts)
+{
+    std::vector<CScript> vPlayerScripts;
+    for (uint32_t i = 0; i < nBenchPlayerCount; i++) {
+        vPlayerScripts.push_back(CScript() << OP_DUP << OP_HASH160 << ToByteVector(GetRandHash()) << OP_EQUALVERIFY << OP_CHECKSIG);
+    }
+
+    for (uint32_t i = 0; i < nBenchPayoutCount; i++) {
+        PeerlessBetKey betKey{i / 100, COutPoint{GetRandHash(), i % 100}};
+        CBetOut payout{(1 + i % 5) * COIN, vPlayerScripts[i % nBenchPlayerCount]};
+        mExpectedPayouts.insert(std::pair<const CPayoutInfoDB, CBetOut>(CPayoutInfoDB{betKey, PayoutType::bettingPayout}, payout));
+        vFoundPayouts.emplace_back(payout.nValue, payout.scriptPubKey);
+    }
+    std::random_shuffle(vFoundPayouts.begin(), vFoundPayouts.end(), [](int n) { return GetRandInt(n); });
+}
+
+/**
+ * Shape of a synthetic betting chain: events are created in the first block,
+ * bets are placed in the following blocks and the results are posted in the last one.
+ */
+struct CBettingChainParams
+{
+    uint32_t nEvents;
+    uint32_t nBets;
+    uint32_t nBetsPerBlock;
+    // every n-th bet is a parlay
+    uint32_t nParlayFreq;
+    uint32_t nParlayLegs;
+    // events resulted in the last block
+    uint32_t nResults;
+};
+
+static const CBettingChainParams benchChainParams{1000, 50000, 500, 4, 3, 250};
+
+/**
+ * Writes a synthetic betting chain starting at the height into the betting view.
+ * @return height of the block with results.
+ */
+static uint32_t GenerateBettingChain(CBettingsView& view, const CBettingChainParams& params, const uint32_t nStartHeight)
+{
+    const int64_t nBetTime = 1600000000;
+    uint32_t nHeight = nStartHeight;
+
+    std::vector<CPeerlessBaseEventDB> vEvents;
+    for (uint32_t i = 0; i < params.nEvents; i++) {
+        CPeerlessExtendedEventDB event;
+        event.nEventId = i;
+        event.nStartTime = nBetTime + 30 * 24 * 60 * 60;
+        event.nHomeOdds = 15000 + GetRandInt(20000);
+        event.nAwayOdds = 15000 + GetRandInt(20000);
+        event.nDrawOdds = 25000 + GetRandInt(20000);
+        event.nEventCreationHeight = nHeight;
+        BOOST_CHECK(view.WriteEvent(EventKey{i}, event));
+        vEvents.emplace_back(event);
+    }
+
+    std::vector<CBitcoinAddress> vPlayers;
+    for (uint32_t i = 0; i < nBenchPlayerCount; i++) {
+        vPlayers.emplace_back(CKeyID(Hash160(ToByteVector(GetRandHash()))));
+    }
+
+    for (uint32_t i = 0; i < params.nBets; i++) {
+        if (i % params.nBetsPerBlock == 0) nHeight++;
+        uint32_t nLegs = i % params.nParlayFreq == 0 ? params.nParlayLegs : 1;
+        std::vector<CPeerlessLegDB> legs;
+        std::vector<CPeerlessBaseEventDB> lockedEvents;
+        uint32_t nEventId = GetRandInt(params.nEvents);
+        for (uint32_t j = 0; j < nLegs; j++) {
+            uint32_t nLegEventId = (nEventId + j) % params.nEvents;
+            legs.emplace_back(nLegEventId, (OutcomeType) (moneyLineHomeWin + GetRandInt(3)));
+            lockedEvents.emplace_back(vEvents[nLegEventId]);
+        }
+        PeerlessBetKey betKey{nHeight, COutPoint{GetRandHash(), 0}};
+        CAmount betAmount = (Params().MinBetPayoutRange() + GetRandInt(1000)) * COIN;
+        BOOST_CHECK(view.bets->Write(betKey, CPeerlessBetDB(betAmount, vPlayers[i % vPlayers.size()], legs, lockedEvents, nBetTime)));
+        BOOST_CHECK(view.SaveEventBets(betKey, legs));
+    }
+
+    nHeight++;
+    std::vector<CPeerlessResultDB> vResults;
+    for (uint32_t i = 0; i < params.nResults; i++) {
+        vResults.emplace_back(i, standardResult, GetRandInt(5), GetRandInt(5));
+        BOOST_CHECK(view.results->Write(ResultKey{i}, vResults.back()));
+    }
+    BOOST_CHECK(view.SaveBlockResults(nHeight, vResults, {}));
+
+    return nHeight;
+}
+
+static bool PayoutsEqual(const std::multimap<CPayoutInfoDB, CBetOut>& mPayouts1, const std::multimap<CPayoutInfoDB, CBetOut>& mPayouts2)
+{
+    if (mPayouts1.size() != mPayouts2.size()) return false;
+    return std::equal(mPayouts1.begin(), mPayouts1.end(), mPayouts2.begin(), [](const std::pair<const CPayoutInfoDB, CBetOut>& a, const std::pair<const CPayoutInfoDB, CBetOut>& b) {
+        return !(a.first < b.first) && !(b.first < a.first) && a.second.nValue == b.second.nValue && a.second.scriptPubKey == b.second.scriptPubKey;
+    });
+}
+
+BOOST_FIXTURE_TEST_SUITE(benchmark_betting, TestingSetup)
+
+BOOST_AUTO_TEST_CASE(benchmark_betting_chain_payouts)
+{
+    // block results are looked up in the global betting view
+    bettingsView->InitCompletedBets();
+    bettingsView->InitParlayLegs();
+    const uint32_t nResultsHeight = GenerateBettingChain(*bettingsView, benchChainParams, Params().WagerrProtocolV3StartHeight());
+    const int nPayoutsHeight = nResultsHeight + 1;
+
+    // payouts
+    std::multimap<CPayoutInfoDB, CBetOut> mExpectedPayouts;
+    CBettingsView payoutsViewCache(bettingsView);
+    CBenchSection section;
+    CAmount nExpectedMint = GetBettingPayouts(payoutsViewCache, nPayoutsHeight, mExpectedPayouts);
+    std::cout << "GetBettingPayouts: " << mExpectedPayouts.size() << " payouts of " << benchChainParams.nBets << " bets in " << section.ToString() << std::endl;
+    BOOST_CHECK(!mExpectedPayouts.empty());
+    BOOST_CHECK(nExpectedMint > 0);
+
+    // evaluation without bet check threads gives the same payouts
+    {
+        const int nThreads = nScriptCheckThreads;
+        nScriptCheckThreads = 0;
+        std::multimap<CPayoutInfoDB, CBetOut> mSerialPayouts;
+        CBettingsView serialViewCache(bettingsView);
+        section.Restart();
+        BOOST_CHECK_EQUAL(GetBettingPayouts(serialViewCache, nPayoutsHeight, mSerialPayouts), nExpectedMint);
+        std::cout << "GetBettingPayouts (single thread): " << mSerialPayouts.size() << " payouts in " << section.ToString() << std::endl;
+        nScriptCheckThreads = nThreads;
+        BOOST_CHECK(PayoutsEqual(mExpectedPayouts, mSerialPayouts));
+    }
+
+    // payouts validation of the block
+    std::vector<CTxOut> vFoundPayouts;
+    std::vector<const CPayoutInfoDB*> vPayoutsInfo;
+    for (const auto& expectedPayout : mExpectedPayouts) {
+        vFoundPayouts.emplace_back(expectedPayout.second.nValue, expectedPayout.second.scriptPubKey);
+    }
+    std::random_shuffle(vFoundPayouts.begin(), vFoundPayouts.end(), [](int n) { return GetRandInt(n); });
+    section.Restart();
+    BOOST_CHECK(MatchExpectedPayouts(mExpectedPayouts, vFoundPayouts, vPayoutsInfo));
+    std::cout << "MatchExpectedPayouts: " << vFoundPayouts.size() << " payouts in " << section.ToString() << std::endl;
+
+    // flush of the connected block
+    section.Restart();
+    BOOST_CHECK(payoutsViewCache.Flush());
+    std::cout << "Flush: " << section.ToString() << std::endl;
+
+    std::vector<PeerlessBetKey> vCompletedBets;
+    BOOST_CHECK(bettingsView->GetCompletedBets(nPayoutsHeight, vCompletedBets));
+    BOOST_CHECK(vCompletedBets.size() >= mExpectedPayouts.size());
+    uint32_t nResolvedParlays = 0;
+    for (const PeerlessBetKey& betKey : vCompletedBets) {
+        CParlayLegsDB parlayLegs;
+        if (!bettingsView->parlayLegs->Read(betKey, parlayLegs)) continue;
+        BOOST_CHECK_EQUAL(parlayLegs.nResolvedLegs, benchChainParams.nParlayLegs);
+        nResolvedParlays++;
+    }
+    BOOST_CHECK(nResolvedParlays > 0);
+
+    // undo of the block
+    CBettingsView undoViewCache(bettingsView);
+    section.Restart();
+    BOOST_CHECK(BettingUndo(undoViewCache, nPayoutsHeight, {}));
+    std::cout << "BettingUndo: " << vCompletedBets.size() << " completed bets in " << section.ToString() << std::endl;
+    for (const PeerlessBetKey& betKey : vCompletedBets) {
+        CPeerlessBetDB bet;
+        BOOST_CHECK(undoViewCache.bets->Read(betKey, bet));
+        BOOST_CHECK(!bet.IsCompleted());
+        BOOST_CHECK(!undoViewCache.parlayLegs->Exists(betKey));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_process_betting_txs)
+{
+    const int nHeight = Params().WagerrProtocolV3StartHeight() + 1;
+    const int64_t nBlockTime = 1600000000;
+
+    // bets are placed with the odds of the events in the global betting view
+    for (uint32_t i = 0; i < benchChainParams.nEvents; i++) {
+        CPeerlessExtendedEventDB event;
+        event.nEventId = i;
+        event.nStartTime = nBlockTime + 30 * 24 * 60 * 60;
+        event.nHomeOdds = 15000 + GetRandInt(20000);
+        event.nAwayOdds = 15000 + GetRandInt(20000);
+        event.nDrawOdds = 25000 + GetRandInt(20000);
+        BOOST_CHECK(bettingsView->WriteEvent(EventKey{i}, event));
+    }
+
+    // the players are found by the outputs the bets spend, looked up in the mempool
+    CMutableTransaction txFunding;
+    for (uint32_t i = 0; i < nBenchPlayerCount; i++) {
+        txFunding.vout.emplace_back(1000 * COIN, GetScriptForDestination(CKeyID(Hash160(ToByteVector(GetRandHash())))));
+    }
+    mempool.addUnchecked(txFunding.GetHash(), CTxMemPoolEntry(txFunding, 0, 0, 0.0, 1));
+
+    std::vector<CTransaction> vTxs;
+    for (uint32_t i = 0; i < nBenchBetTxCount; i++) {
+        uint32_t nEventId = GetRandInt(benchChainParams.nEvents);
+        CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+        if (i % benchChainParams.nParlayFreq == 0) {
+            CPeerlessParlayBetTx parlayBetTx;
+            for (uint32_t j = 0; j < benchChainParams.nParlayLegs; j++) {
+                parlayBetTx.legs.emplace_back((nEventId + j) % benchChainParams.nEvents, moneyLineHomeWin + GetRandInt(3));
+            }
+            ss << CBettingTxHeader{BTX_PREFIX, BTX_FORMAT_VERSION, plParlayBetTxType} << parlayBetTx;
+        } else {
+            ss << CBettingTxHeader{BTX_PREFIX, BTX_FORMAT_VERSION, plBetTxType} << CPeerlessBetTx{nEventId, (uint8_t) (moneyLineHomeWin + GetRandInt(3))};
+        }
+        CMutableTransaction mtx;
+        mtx.vin.emplace_back(COutPoint{txFunding.GetHash(), i % nBenchPlayerCount});
+        mtx.vout.emplace_back((Params().MinBetPayoutRange() + GetRandInt(1000)) * COIN, CScript() << OP_RETURN << std::vector<unsigned char>(ss.begin(), ss.end()));
+        vTxs.emplace_back(mtx);
+    }
+
+    CBettingsView viewCache(bettingsView);
+    CBenchSection section;
+    for (const CTransaction& tx : vTxs) {
+        ProcessBettingTx(viewCache, tx, nHeight, nBlockTime, true);
+    }
+    std::cout << "ProcessBettingTx: " << vTxs.size() << " bet transactions in " << section.ToString() << std::endl;
+
+    for (const CTransaction& tx : vTxs) {
+        BOOST_CHECK(viewCache.bets->Exists(PeerlessBetKey{static_cast<uint32_t>(nHeight), COutPoint{tx.GetHash(), 0}}));
+    }
+
+    mempool.clear();
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_match_block_payouts)
+{
+    std::multimap<CPayoutInfoDB, CBetOut> mExpectedPayouts;
+    std::vector<CTxOut> vFoundPayouts;
+    std::vector<const CPayoutInfoDB*> vPayoutsInfo;
+    BuildBlockPayouts(mExpectedPayouts, vFoundPayouts);
+
+    CBenchSection section;
+    BOOST_CHECK(MatchExpectedPayouts(mExpectedPayouts, vFoundPayouts, vPayoutsInfo));
+    std::cout << "Matched " << vFoundPayouts.size() << " block payouts in " << section.ToString() << std::endl;
+
+    // every payout info is used once and belongs to a payout of the same value and script
+    BOOST_CHECK_EQUAL(vPayoutsInfo.size(), vFoundPayouts.size());
+    std::map<const CPayoutInfoDB*, size_t> mapUsed;
+    for (size_t i = 0; i < vPayoutsInfo.size(); i++) {
+        BOOST_CHECK(mapUsed.emplace(vPayoutsInfo[i], i).second);
+    }
+    for (const auto& expectedPayout : mExpectedPayouts) {
+        auto it = mapUsed.find(&expectedPayout.first);
+        BOOST_REQUIRE(it != mapUsed.end());
+        BOOST_CHECK(vFoundPayouts[it->second].nValue == expectedPayout.second.nValue);
+        BOOST_CHECK(vFoundPayouts[it->second].scriptPubKey == expectedPayout.second.scriptPubKey);
+    }
+
+    // a single altered or missing payout invalidates the block
+    vFoundPayouts.back().nValue += 1;
+    BOOST_CHECK(!MatchExpectedPayouts(mExpectedPayouts, vFoundPayouts, vPayoutsInfo));
+    vFoundPayouts.pop_back();
+    BOOST_CHECK(!MatchExpectedPayouts(mExpectedPayouts, vFoundPayouts, vPayoutsInfo));
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_cached_bets_lookup)
+{
+    CBettingDB betsCache{*bettingsView->bets};
+    std::vector<PeerlessBetKey> vKeys;
+    for (uint32_t i = 0; i < nBenchCachedBetCount; i++) {
+        vKeys.emplace_back(PeerlessBetKey{i / 100, COutPoint{GetRandHash(), i % 100}});
+        BOOST_CHECK(betsCache.Write(vKeys.back(), CPeerlessBetDB{}));
+    }
+
+    CPeerlessBetDB bet;
+    uint32_t nFound = 0;
+    CBenchSection section;
+    for (const PeerlessBetKey& key : vKeys) {
+        if (betsCache.Read(key, bet)) nFound++;
+    }
+    std::cout << "Read " << nFound << " cached bets in " << section.ToString() << std::endl;
+    BOOST_CHECK_EQUAL(nFound, nBenchCachedBetCount);
+
+    // the cached bets are iterated in key order
+    uint32_t nIterated = 0;
+    PeerlessBetKey prevKey{0, COutPoint{}};
+    auto it = betsCache.NewIterator();
+    for (it->Seek(std::vector<unsigned char>{}); it->Valid(); it->Next()) {
+        PeerlessBetKey key;
+        CBettingDB::BytesToDbType(it->KeySlice(), key);
+        BOOST_CHECK(nIterated == 0 || prevKey.blockHeight <= key.blockHeight);
+        prevKey = key;
+        nIterated++;
+    }
+    BOOST_CHECK_EQUAL(nIterated, nBenchCachedBetCount);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,66 @@
+// Copyright (c) 2020 The Wagerr developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "chain.h"
+#include "main.h"
+#include "test/bench_wagerr.h"
+#include "test/test_wagerr.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+static constexpr unsigned int nBenchIndexCount{300000};
+
+/** Resident memory of the process in KiB, -1 where /proc isn't available */
+static long GetResidentMemoryKiB()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0)
+            return std::stol(line.substr(6));
+    }
+    return -1;
+}
+
+BOOST_FIXTURE_TEST_SUITE(benchmark_blockindex, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(benchmark_blockindex_memory)
+{
+    BlockMap mapIndex;
+    long nStartKiB = GetResidentMemoryKiB();
+    CBenchSection section;
+
+    // link the entries as LoadBlockIndexGuts does, proof of stake after the first blocks
+    CBlockIndex* pprev = nullptr;
+    for (unsigned int i = 0; i < nBenchIndexCount; i++) {
+        uint256 hash = (uint256(i) << 128) | uint256(i);
+        CBlockIndex* pindexNew = new CBlockIndex();
+        BlockMap::iterator mi = mapIndex.insert(std::make_pair(hash, pindexNew)).first;
+        pindexNew->phashBlock = &((*mi).first);
+        pindexNew->pprev = pprev;
+        pindexNew->nHeight = i;
+        pindexNew->nVersion = i < 1500 ? 3 : 7;
+        pindexNew->nStatus = BLOCK_VALID_SCRIPTS | BLOCK_HAVE_DATA | BLOCK_HAVE_UNDO;
+        if (i > 1001)
+            pindexNew->SetProofOfStake();
+        pprev = pindexNew;
+    }
+
+    std::cout << "Block index: " << nBenchIndexCount << " entries linked in " << section.ToString() << std::endl;
+    long nEndKiB = GetResidentMemoryKiB();
+    if (nStartKiB >= 0 && nEndKiB >= 0) {
+        std::cout << "Block index: " << nBenchIndexCount << " entries of " << sizeof(CBlockIndex) << " bytes, "
+                  << (nEndKiB - nStartKiB) * 1024.0 / nBenchIndexCount << " resident bytes per entry" << std::endl;
+    }
+
+    BOOST_CHECK_EQUAL(mapIndex.size(), nBenchIndexCount);
+    for (auto& entry : mapIndex)
+        delete entry.second;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
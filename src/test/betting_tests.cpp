@@ -4,7 +4,10 @@
 
 #include "betting/bet.h"
 #include "betting/bet_db.h"
+#include "betting/quickgames/dice.h"
+#include "clientversion.h"
 #include "random.h"
+#include "streams.h"
 #include "uint256.h"
 #include "test/test_wagerr.h"
 #include <cstdlib>
@@ -230,4 +233,464 @@ BOOST_AUTO_TEST_CASE(betting_flushable_reverse_db_iterator_test)
     std::cout << "Testing of flushable reverse DB iterator passed" << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(betting_event_bets_index_test)
+{
+    CBettingsView bettingsViewCache(bettingsView);
+
+    uint256 txHash = GetRandHash();
+    PeerlessBetKey singleKey{100, COutPoint{txHash, 0}};
+    PeerlessBetKey parlayKey{200, COutPoint{txHash, 1}};
+    PeerlessBetKey otherKey{300, COutPoint{txHash, 2}};
+
+    BOOST_CHECK(bettingsViewCache.SaveEventBets(singleKey, {CPeerlessLegDB{1, moneyLineHomeWin}}));
+    BOOST_CHECK(bettingsViewCache.SaveEventBets(parlayKey, {CPeerlessLegDB{1, moneyLineAwayWin}, CPeerlessLegDB{2, totalOver}}));
+    BOOST_CHECK(bettingsViewCache.SaveEventBets(otherKey, {CPeerlessLegDB{3, spreadHome}}));
+
+    // parlay must be indexed under each leg's event
+    std::vector<PeerlessBetKey> vKeys = bettingsViewCache.GetEventBets(1, 0);
+    BOOST_CHECK_EQUAL(vKeys.size(), 2);
+    BOOST_CHECK(vKeys[0] == singleKey);
+    BOOST_CHECK(vKeys[1] == parlayKey);
+
+    vKeys = bettingsViewCache.GetEventBets(2, 0);
+    BOOST_CHECK_EQUAL(vKeys.size(), 1);
+    BOOST_CHECK(vKeys[0] == parlayKey);
+
+    // bets placed before start height must be skipped
+    vKeys = bettingsViewCache.GetEventBets(1, 150);
+    BOOST_CHECK_EQUAL(vKeys.size(), 1);
+    BOOST_CHECK(vKeys[0] == parlayKey);
+
+    BOOST_CHECK(bettingsViewCache.GetEventBets(4, 0).empty());
+
+    // undo of parlay bet
+    BOOST_CHECK(bettingsViewCache.EraseEventBets(parlayKey, {CPeerlessLegDB{1, moneyLineAwayWin}, CPeerlessLegDB{2, totalOver}}));
+    vKeys = bettingsViewCache.GetEventBets(1, 0);
+    BOOST_CHECK_EQUAL(vKeys.size(), 1);
+    BOOST_CHECK(vKeys[0] == singleKey);
+    BOOST_CHECK(bettingsViewCache.GetEventBets(2, 0).empty());
+
+    // global view must be untouched until flush
+    BOOST_CHECK(bettingsView->GetEventBets(1, 0).empty());
+    BOOST_CHECK(bettingsViewCache.Flush());
+    BOOST_CHECK_EQUAL(bettingsView->GetEventBets(1, 0).size(), 1);
+    BOOST_CHECK_EQUAL(bettingsView->GetEventBets(3, 0).size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(betting_mapping_names_test)
+{
+    CBettingsView globalView(bettingsView);
+    std::string sportName{"Mapping names test sport"};
+    std::string otherName{"Mapping names test other sport"};
+    BOOST_CHECK(globalView.mappings->Write(MappingKey{sportMapping, 9001}, CMappingDB{sportName}));
+    globalView.LoadMappingNames();
+
+    CMappingDB mapping;
+    uint32_t id = 0;
+    BOOST_CHECK(globalView.ReadMapping(MappingKey{sportMapping, 9001}, mapping));
+    BOOST_CHECK_EQUAL(mapping.sName, sportName);
+    BOOST_CHECK(globalView.GetMappingId(sportMapping, sportName, id));
+    BOOST_CHECK_EQUAL(id, 9001);
+    BOOST_CHECK(!globalView.GetMappingId(teamMapping, sportName, id));
+
+    // changes are visible in the dictionary after flushing of cache view
+    {
+        CBettingsView viewCache(&globalView);
+        BOOST_CHECK(viewCache.mappings->Write(MappingKey{sportMapping, 9000}, CMappingDB{sportName}));
+        BOOST_CHECK(viewCache.mappings->Write(MappingKey{sportMapping, 9002}, CMappingDB{otherName}));
+        BOOST_CHECK(!globalView.ReadMapping(MappingKey{sportMapping, 9002}, mapping));
+        BOOST_CHECK(viewCache.Flush());
+    }
+    BOOST_CHECK(globalView.ReadMapping(MappingKey{sportMapping, 9002}, mapping));
+    BOOST_CHECK_EQUAL(mapping.sName, otherName);
+    // the lowest id of the name is used
+    BOOST_CHECK(globalView.GetMappingId(sportMapping, sportName, id));
+    BOOST_CHECK_EQUAL(id, 9000);
+
+    // undo of mapping
+    {
+        CBettingsView viewCache(&globalView);
+        BOOST_CHECK(viewCache.mappings->Erase(MappingKey{sportMapping, 9000}));
+        BOOST_CHECK(viewCache.Flush());
+    }
+    BOOST_CHECK(!globalView.ReadMapping(MappingKey{sportMapping, 9000}, mapping));
+    BOOST_CHECK(globalView.GetMappingId(sportMapping, sportName, id));
+    BOOST_CHECK_EQUAL(id, 9001);
+}
+
+BOOST_AUTO_TEST_CASE(betting_upcoming_events_test)
+{
+    CBettingsView bettingsViewCache(bettingsView);
+
+    // far future start times, not overlapped with events of other tests
+    const uint64_t nNow = 4000000000ULL;
+    CPeerlessExtendedEventDB event1, event2, event3;
+    event1.nEventId = 901; event1.nStartTime = nNow + 200;
+    event2.nEventId = 902; event2.nStartTime = nNow - 100;
+    event3.nEventId = 903; event3.nStartTime = nNow + 100;
+
+    BOOST_CHECK(bettingsViewCache.WriteEvent(EventKey{event1.nEventId}, event1));
+    BOOST_CHECK(bettingsViewCache.WriteEvent(EventKey{event2.nEventId}, event2));
+    BOOST_CHECK(bettingsViewCache.WriteEvent(EventKey{event3.nEventId}, event3));
+
+    // started events are skipped, upcoming ones are ordered by id
+    auto vEvents = bettingsViewCache.GetUpcomingEvents(nNow);
+    BOOST_CHECK_EQUAL(vEvents.size(), 2);
+    BOOST_CHECK_EQUAL(vEvents[0].nEventId, 901);
+    BOOST_CHECK_EQUAL(vEvents[1].nEventId, 903);
+
+    // patch of start time moves the event
+    event2.nStartTime = nNow + 300;
+    BOOST_CHECK(bettingsViewCache.UpdateEvent(EventKey{event2.nEventId}, event2));
+    event1.nStartTime = nNow - 1;
+    BOOST_CHECK(bettingsViewCache.UpdateEvent(EventKey{event1.nEventId}, event1));
+    vEvents = bettingsViewCache.GetUpcomingEvents(nNow);
+    BOOST_CHECK_EQUAL(vEvents.size(), 2);
+    BOOST_CHECK_EQUAL(vEvents[0].nEventId, 902);
+    BOOST_CHECK_EQUAL(vEvents[1].nEventId, 903);
+
+    // undo of event
+    BOOST_CHECK(bettingsViewCache.EraseEvent(EventKey{event3.nEventId}));
+    vEvents = bettingsViewCache.GetUpcomingEvents(nNow);
+    BOOST_CHECK_EQUAL(vEvents.size(), 1);
+    BOOST_CHECK_EQUAL(vEvents[0].nEventId, 902);
+}
+
+BOOST_AUTO_TEST_CASE(betting_upcoming_events_set_test)
+{
+    CBettingsView globalView(bettingsView);
+    const uint64_t nNow = 4000000000ULL;
+    std::string sportName{"Upcoming test sport"};
+    std::string tournamentName{"Upcoming test tournament"};
+    std::string homeName{"Upcoming test home"};
+    std::string awayName{"Upcoming test away"};
+    std::string otherName{"Upcoming test other"};
+    std::string renamedName{"Upcoming test renamed"};
+    CPeerlessExtendedEventDB event1, event2;
+    event1.nEventId = 911; event1.nStartTime = nNow + 100;
+    event1.nSport = 9011; event1.nTournament = 9012; event1.nHomeTeam = 9013; event1.nAwayTeam = 9014;
+    event2.nEventId = 912; event2.nStartTime = nNow + 200;
+    event2.nSport = 9011; event2.nTournament = 9012; event2.nHomeTeam = 9014; event2.nAwayTeam = 9015;
+
+    BOOST_CHECK(globalView.mappings->Write(MappingKey{sportMapping, 9011}, CMappingDB{sportName}));
+    BOOST_CHECK(globalView.mappings->Write(MappingKey{tournamentMapping, 9012}, CMappingDB{tournamentName}));
+    BOOST_CHECK(globalView.mappings->Write(MappingKey{teamMapping, 9013}, CMappingDB{homeName}));
+    BOOST_CHECK(globalView.mappings->Write(MappingKey{teamMapping, 9014}, CMappingDB{awayName}));
+    BOOST_CHECK(globalView.WriteEvent(EventKey{event1.nEventId}, event1));
+    globalView.LoadMappingNames();
+    globalView.LoadUpcomingEvents(nNow);
+
+    auto vEvents = globalView.GetUpcomingEvents(nNow);
+    BOOST_CHECK_EQUAL(vEvents.size(), 1);
+    BOOST_CHECK_EQUAL(vEvents[0].nEventId, 911);
+    BOOST_CHECK(vEvents[0].fNamesResolved);
+    BOOST_CHECK_EQUAL(vEvents[0].sSport, sportName);
+    BOOST_CHECK_EQUAL(vEvents[0].sHomeTeam, homeName);
+
+    // new events are visible after flushing of cache view, the names are resolved when their mappings come
+    {
+        CBettingsView viewCache(&globalView);
+        BOOST_CHECK(viewCache.WriteEvent(EventKey{event2.nEventId}, event2));
+        BOOST_CHECK(viewCache.Flush());
+    }
+    vEvents = globalView.GetUpcomingEvents(nNow);
+    BOOST_CHECK_EQUAL(vEvents.size(), 2);
+    BOOST_CHECK_EQUAL(vEvents[1].nEventId, 912);
+    BOOST_CHECK(!vEvents[1].fNamesResolved);
+    {
+        CBettingsView viewCache(&globalView);
+        BOOST_CHECK(viewCache.mappings->Write(MappingKey{teamMapping, 9015}, CMappingDB{otherName}));
+        BOOST_CHECK(viewCache.mappings->Update(MappingKey{teamMapping, 9014}, CMappingDB{renamedName}));
+        BOOST_CHECK(viewCache.Flush());
+    }
+    vEvents = globalView.GetUpcomingEvents(nNow);
+    BOOST_CHECK_EQUAL(vEvents.size(), 2);
+    BOOST_CHECK_EQUAL(vEvents[0].sAwayTeam, renamedName);
+    BOOST_CHECK(vEvents[1].fNamesResolved);
+    BOOST_CHECK_EQUAL(vEvents[1].sHomeTeam, renamedName);
+    BOOST_CHECK_EQUAL(vEvents[1].sAwayTeam, otherName);
+
+    // patch of odds and undo of event
+    {
+        CBettingsView viewCache(&globalView);
+        event1.nHomeOdds = 15000;
+        BOOST_CHECK(viewCache.UpdateEvent(EventKey{event1.nEventId}, event1));
+        BOOST_CHECK(viewCache.EraseEvent(EventKey{event2.nEventId}));
+        BOOST_CHECK(viewCache.Flush());
+    }
+    vEvents = globalView.GetUpcomingEvents(nNow);
+    BOOST_CHECK_EQUAL(vEvents.size(), 1);
+    BOOST_CHECK_EQUAL(vEvents[0].nHomeOdds, 15000);
+
+    // started events are dropped
+    BOOST_CHECK(globalView.GetUpcomingEvents(nNow + 150).empty());
+    BOOST_CHECK(globalView.GetUpcomingEvents(nNow).empty());
+}
+
+BOOST_AUTO_TEST_CASE(betting_player_bets_index_test)
+{
+    CBettingsView bettingsViewCache(bettingsView);
+
+    CBitcoinAddress playerA{CKeyID(uint160(std::vector<unsigned char>(20, 0x0a)))};
+    CBitcoinAddress playerB{CKeyID(uint160(std::vector<unsigned char>(20, 0x0b)))};
+    CBitcoinAddress playerC{CKeyID(uint160(std::vector<unsigned char>(20, 0x0c)))};
+    uint256 txHash = GetRandHash();
+    PeerlessBetKey keyA1{100, COutPoint{txHash, 0}};
+    PeerlessBetKey keyB1{100, COutPoint{txHash, 1}};
+    PeerlessBetKey keyA2{200, COutPoint{txHash, 2}};
+    PeerlessBetKey keyC1{250, COutPoint{txHash, 3}};
+    PeerlessBetKey keyB2{300, COutPoint{txHash, 4}};
+
+    BOOST_CHECK(bettingsViewCache.SavePlayerBet(playerA, playerPeerlessBet, keyA1));
+    BOOST_CHECK(bettingsViewCache.SavePlayerBet(playerB, playerPeerlessBet, keyB1));
+    BOOST_CHECK(bettingsViewCache.SavePlayerBet(playerA, playerPeerlessBet, keyA2));
+    BOOST_CHECK(bettingsViewCache.SavePlayerBet(playerC, playerPeerlessBet, keyC1));
+    BOOST_CHECK(bettingsViewCache.SavePlayerBet(playerB, playerPeerlessBet, keyB2));
+    BOOST_CHECK(bettingsViewCache.SavePlayerBet(playerA, playerQuickGamesBet, keyC1));
+
+    std::set<CScript> playerScripts{GetScriptForDestination(playerA.Get()), GetScriptForDestination(playerB.Get())};
+    std::vector<PeerlessBetKey> vKeys;
+    auto collect = [&vKeys](const PeerlessBetKey& key) { vKeys.emplace_back(key); return true; };
+
+    // bets of both players merged from newest to oldest, other players and bet types skipped
+    bettingsViewCache.ForEachPlayerBet(playerScripts, playerPeerlessBet, collect);
+    BOOST_CHECK_EQUAL(vKeys.size(), 4);
+    BOOST_CHECK(vKeys[0] == keyB2);
+    BOOST_CHECK(vKeys[1] == keyA2);
+    BOOST_CHECK(vKeys[2] == keyB1);
+    BOOST_CHECK(vKeys[3] == keyA1);
+
+    // walk stops when callback returns false
+    vKeys.clear();
+    bettingsViewCache.ForEachPlayerBet(playerScripts, playerPeerlessBet, [&vKeys](const PeerlessBetKey& key) { vKeys.emplace_back(key); return vKeys.size() < 2; });
+    BOOST_CHECK_EQUAL(vKeys.size(), 2);
+
+    vKeys.clear();
+    bettingsViewCache.ForEachPlayerBet(playerScripts, playerQuickGamesBet, collect);
+    BOOST_CHECK_EQUAL(vKeys.size(), 1);
+    BOOST_CHECK(vKeys[0] == keyC1);
+
+    // undo of bet
+    BOOST_CHECK(bettingsViewCache.ErasePlayerBet(playerB, playerPeerlessBet, keyB2));
+    vKeys.clear();
+    bettingsViewCache.ForEachPlayerBet(playerScripts, playerPeerlessBet, collect);
+    BOOST_CHECK_EQUAL(vKeys.size(), 3);
+    BOOST_CHECK(vKeys[0] == keyA2);
+}
+
+BOOST_AUTO_TEST_CASE(betting_txs_index_test)
+{
+    CBettingsView bettingsViewCache(bettingsView);
+
+    uint256 betTxHash = GetRandHash();
+    uint256 payoutTxHash = GetRandHash();
+    uint32_t height = 0;
+
+    BOOST_CHECK(bettingsViewCache.SaveBettingTx(betTxHash, 100));
+    BOOST_CHECK(bettingsViewCache.SaveBettingTx(payoutTxHash, 120));
+    // several bet outputs of one tx share the entry
+    BOOST_CHECK(!bettingsViewCache.SaveBettingTx(betTxHash, 100));
+
+    BOOST_CHECK(bettingsViewCache.GetBettingTxHeight(betTxHash, height));
+    BOOST_CHECK_EQUAL(height, 100);
+    BOOST_CHECK(bettingsViewCache.GetBettingTxHeight(payoutTxHash, height));
+    BOOST_CHECK_EQUAL(height, 120);
+    BOOST_CHECK(!bettingsViewCache.GetBettingTxHeight(GetRandHash(), height));
+
+    // undo of bet
+    BOOST_CHECK(bettingsViewCache.EraseBettingTx(betTxHash));
+    BOOST_CHECK(!bettingsViewCache.GetBettingTxHeight(betTxHash, height));
+}
+
+BOOST_AUTO_TEST_CASE(betting_undos_prune_test)
+{
+    CBettingsView bettingsViewCache(bettingsView);
+
+    std::vector<BettingUndoKey> vUndoKeys;
+    for (uint32_t height : {30, 10, 20, 10}) {
+        vUndoKeys.emplace_back(GetRandHash());
+        BOOST_CHECK(bettingsViewCache.SaveBettingUndo(vUndoKeys.back(), {CBettingUndoDB{BettingUndoVariant{CPeerlessExtendedEventDB{}}, height}}));
+    }
+    // undo of tx
+    BOOST_CHECK(bettingsViewCache.EraseBettingUndo(vUndoKeys[3]));
+
+    bettingsViewCache.PruneOlderUndos(20);
+    BOOST_CHECK(bettingsViewCache.ExistsBettingUndo(vUndoKeys[0]));
+    BOOST_CHECK(!bettingsViewCache.ExistsBettingUndo(vUndoKeys[1]));
+    BOOST_CHECK(bettingsViewCache.ExistsBettingUndo(vUndoKeys[2]));
+
+    bettingsViewCache.PruneOlderUndos(31);
+    BOOST_CHECK(!bettingsViewCache.ExistsBettingUndo(vUndoKeys[0]));
+    BOOST_CHECK(!bettingsViewCache.ExistsBettingUndo(vUndoKeys[2]));
+    BOOST_CHECK(!bettingsViewCache.undoHeights->Exists(UndoHeightKey{30, vUndoKeys[0]}));
+}
+
+BOOST_AUTO_TEST_CASE(betting_completed_bets_test)
+{
+    CBettingsView bettingsViewCache(bettingsView);
+
+    PeerlessBetKey key1{90, COutPoint{GetRandHash(), 0}};
+    PeerlessBetKey key2{95, COutPoint{GetRandHash(), 1}};
+    PeerlessBetKey key3{99, COutPoint{GetRandHash(), 0}};
+    std::vector<PeerlessBetKey> vBetKeys;
+
+    // blocks connected before recording have no records
+    BOOST_CHECK(!bettingsViewCache.GetCompletedBets(100, vBetKeys));
+    bettingsViewCache.completedBets->Write(std::string("StartHeight"), (uint32_t) 100);
+
+    BOOST_CHECK(bettingsViewCache.SaveCompletedBet(100, key1));
+    BOOST_CHECK(bettingsViewCache.SaveCompletedBet(101, key2));
+    BOOST_CHECK(bettingsViewCache.SaveCompletedBet(101, key3));
+
+    BOOST_CHECK(!bettingsViewCache.GetCompletedBets(99, vBetKeys));
+    BOOST_CHECK(bettingsViewCache.GetCompletedBets(101, vBetKeys));
+    BOOST_CHECK_EQUAL(vBetKeys.size(), 2);
+    BOOST_CHECK(bettingsViewCache.GetCompletedBets(102, vBetKeys));
+    BOOST_CHECK(vBetKeys.empty());
+
+    // undo of payouts
+    BOOST_CHECK(bettingsViewCache.EraseCompletedBets(101));
+    BOOST_CHECK(bettingsViewCache.GetCompletedBets(101, vBetKeys));
+    BOOST_CHECK(vBetKeys.empty());
+
+    bettingsViewCache.PruneOlderCompletedBets(101);
+    BOOST_CHECK(bettingsViewCache.GetCompletedBets(100, vBetKeys));
+    BOOST_CHECK(vBetKeys.empty());
+    BOOST_CHECK(bettingsViewCache.completedBets->Exists(std::string("StartHeight")));
+}
+
+BOOST_AUTO_TEST_CASE(betting_parlay_legs_test)
+{
+    CBettingsView bettingsViewCache(bettingsView);
+    PeerlessBetKey betKey{1000, COutPoint{GetRandHash(), 0}};
+    CParlayLegsDB parlayLegs(3);
+
+    parlayLegs.ResolveLeg(1, 1010, {20000, 19000});
+    parlayLegs.ResolveLeg(1, 1010, {20000, 19000});
+    BOOST_CHECK_EQUAL(parlayLegs.nResolvedLegs, 1);
+    BOOST_CHECK(bettingsViewCache.SaveParlayLegs(betKey, parlayLegs));
+    parlayLegs.ResolveLeg(0, 1020, {10000, 10000});
+    BOOST_CHECK(bettingsViewCache.SaveParlayLegs(betKey, parlayLegs));
+
+    CParlayLegsDB savedLegs;
+    BOOST_CHECK(bettingsViewCache.parlayLegs->Read(betKey, savedLegs));
+    BOOST_CHECK_EQUAL(savedLegs.nResolvedLegs, 2);
+    BOOST_CHECK(savedLegs.vLegs[0].IsResolved());
+    BOOST_CHECK_EQUAL(savedLegs.vLegs[1].nResolveHeight, 1010);
+    BOOST_CHECK_EQUAL(savedLegs.vLegs[1].nEffectiveOdds, 19000);
+    BOOST_CHECK(!savedLegs.vLegs[2].IsResolved());
+
+    // state without resolved legs isn't kept
+    savedLegs.UnresolveLeg(0);
+    savedLegs.UnresolveLeg(1);
+    BOOST_CHECK_EQUAL(savedLegs.nResolvedLegs, 0);
+    BOOST_CHECK(bettingsViewCache.SaveParlayLegs(betKey, savedLegs));
+    BOOST_CHECK(!bettingsViewCache.parlayLegs->Exists(betKey));
+}
+
+BOOST_AUTO_TEST_CASE(betting_check_indexes_test)
+{
+    // indexes are flushed by the rebuild, keep the changes away from the global view
+    CBettingsView parentView(bettingsView);
+    CBettingsView bettingsViewCache(&parentView);
+
+    CBitcoinAddress player{CKeyID(uint160(std::vector<unsigned char>(20, 0x0d)))};
+    PeerlessBetKey betKey{110, COutPoint{GetRandHash(), 0}};
+    CPeerlessBetDB bet{1000, player, {CPeerlessLegDB{701, moneyLineHomeWin}}, {}, 0};
+    uint256 hashOld = GetRandHash();
+    uint256 hashNew = GetRandHash();
+
+    // blocks connected by an older version, which doesn't maintain the indexes and the marker
+    BOOST_CHECK(bettingsViewCache.bets->Write(betKey, bet));
+    BOOST_CHECK(bettingsViewCache.blockResults->Write(BlockResultsKey{110}, CBlockResultsDB{}));
+    BOOST_CHECK(bettingsViewCache.blockResults->Write(std::string("StartHeight"), (uint32_t) 100));
+    bettingsViewCache.SetLastHeight(120, hashOld);
+    bettingsViewCache.blockResults->Erase(std::string("IndexedBlock"));
+
+    BOOST_CHECK(!bettingsViewCache.IndexesSynced(hashOld));
+    bettingsViewCache.RebuildIndexes(hashOld);
+    BOOST_CHECK(bettingsViewCache.IndexesSynced(hashOld));
+    BOOST_CHECK_EQUAL(bettingsViewCache.GetEventBets(701, 0).size(), 1);
+    uint32_t height = 0;
+    BOOST_CHECK(bettingsViewCache.GetBettingTxHeight(betKey.outPoint.hash, height));
+    BOOST_CHECK_EQUAL(height, 110);
+    // per block records are restarted after the last block
+    BOOST_CHECK(!bettingsViewCache.blockResults->Exists(BlockResultsKey{110}));
+    BOOST_CHECK(!bettingsViewCache.blockResults->Exists(std::string("StartHeight")));
+    // the mark isn't kept in the undos DB iterated by older versions
+    BOOST_CHECK(!bettingsViewCache.undos->Exists(std::string("IndexedBlock")));
+
+    // block at the last height replaced by an older version
+    BOOST_CHECK(!bettingsViewCache.IndexesSynced(hashNew));
+    bettingsViewCache.RebuildIndexes(hashNew);
+    BOOST_CHECK(bettingsViewCache.IndexesSynced(hashNew));
+    BOOST_CHECK_EQUAL(bettingsViewCache.GetEventBets(701, 0).size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(betting_db_clear_test)
+{
+    CBettingsView parentView(bettingsView);
+    CBettingsView bettingsViewCache(&parentView);
+
+    // more entries than fit in one erase batch
+    for (uint32_t height = 0; height < 25000; height++) {
+        BOOST_CHECK(bettingsViewCache.undoHeights->Write(UndoHeightKey{height, BettingUndoKey{}}, 0));
+    }
+    bettingsViewCache.undoHeights->Clear();
+
+    auto it = bettingsViewCache.undoHeights->NewIterator();
+    it->Seek(std::vector<unsigned char>{});
+    BOOST_CHECK(!it->Valid());
+    BOOST_CHECK_EQUAL(bettingsViewCache.undoHeights->GetCacheSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(betting_dice_batch_handler_test)
+{
+    std::vector<std::vector<unsigned char>> vBetInfos;
+    for (uint32_t betType = quickgames::qgDiceEqual; betType <= quickgames::qgDiceOdd; betType++) {
+        for (uint32_t betNumber = 2; betNumber <= 12; betNumber++) {
+            if ((betType == quickgames::qgDiceTotalOver || betType == quickgames::qgDiceTotalUnder) && betNumber == 12) continue;
+            quickgames::DiceBetInfo info{(quickgames::QuickGamesDiceBetType) betType, betNumber};
+            CDataStream ss{SER_NETWORK, CLIENT_VERSION};
+            ss << info;
+            vBetInfos.emplace_back(ss.begin(), ss.end());
+        }
+    }
+    std::vector<const std::vector<unsigned char>*> vBetInfoPtrs;
+    for (const auto& betInfo : vBetInfos) {
+        vBetInfoPtrs.push_back(&betInfo);
+    }
+
+    // batch of bets is settled like every bet alone
+    for (int i = 0; i < 20; i++) {
+        uint256 seed = GetRandHash();
+        std::vector<uint32_t> vOdds;
+        quickgames::DiceBatchHandler(vBetInfoPtrs, seed, vOdds);
+        BOOST_REQUIRE_EQUAL(vOdds.size(), vBetInfos.size());
+        for (size_t j = 0; j < vBetInfos.size(); j++) {
+            BOOST_CHECK_EQUAL(vOdds[j], quickgames::DiceHandler(vBetInfos[j], seed));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(betting_block_results_test)
+{
+    CBettingsView bettingsViewCache(bettingsView);
+    CBlockResultsDB results;
+
+    // blocks connected before recording have to be read from disk
+    BOOST_CHECK(!bettingsViewCache.GetBlockResults(100, results));
+    BOOST_CHECK(bettingsViewCache.blockResults->Write(std::string("StartHeight"), (uint32_t) 100));
+    bettingsViewCache.SetLastHeight(101, uint256(101));
+
+    BOOST_CHECK(bettingsViewCache.SaveBlockResults(101, {CPeerlessResultDB{}}, {}));
+    BOOST_CHECK(!bettingsViewCache.GetBlockResults(99, results));
+    BOOST_CHECK(bettingsViewCache.GetBlockResults(100, results));
+    BOOST_CHECK(results.vPeerlessResults.empty());
+    BOOST_CHECK(bettingsViewCache.GetBlockResults(101, results));
+    BOOST_CHECK_EQUAL(results.vPeerlessResults.size(), 1);
+    // blocks after the last connected one aren't recorded yet
+    BOOST_CHECK(!bettingsViewCache.GetBlockResults(102, results));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
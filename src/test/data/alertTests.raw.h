@@ -0,0 +1,163 @@
+namespace alert_tests{
+static unsigned const char alertTests[] = {
+0x41, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x51, 0x01, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x59, 0x3e, 0x0f, 0x00, 0x00, 0x01, 
+0x00, 0x00, 0x00, 0x0d, 0x41, 0x6c, 0x65, 0x72, 
+0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 
+0x74, 0x07, 0x41, 0x6c, 0x65, 0x72, 0x74, 0x20, 
+0x31, 0x00, 0x47, 0x30, 0x45, 0x02, 0x21, 0x00, 
+0x85, 0x8c, 0x75, 0xb7, 0x1b, 0xf2, 0xe0, 0xd6, 
+0x01, 0x78, 0xf7, 0xb7, 0x57, 0x43, 0xae, 0xee, 
+0x72, 0xe7, 0x3b, 0x89, 0xd1, 0x8c, 0xcf, 0x9f, 
+0x10, 0x0f, 0x77, 0x0d, 0x72, 0x7e, 0x7e, 0xc9, 
+0x02, 0x20, 0x2f, 0x95, 0x81, 0xe0, 0x63, 0xbf, 
+0x04, 0x40, 0xe8, 0x88, 0xb4, 0x6f, 0xed, 0x6f, 
+0x73, 0x07, 0xe0, 0x7f, 0xdd, 0x36, 0x40, 0x96, 
+0xdb, 0xb4, 0x32, 0x40, 0x72, 0x59, 0xff, 0xaa, 
+0x77, 0x90, 0x63, 0x01, 0x00, 0x00, 0x00, 0x3c, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 
+0x51, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x59, 0x3e, 0x0f, 0x00, 
+0x01, 0x0f, 0x2f, 0x53, 0x61, 0x74, 0x6f, 0x73, 
+0x68, 0x69, 0x3a, 0x30, 0x2e, 0x31, 0x2e, 0x30, 
+0x2f, 0x01, 0x00, 0x00, 0x00, 0x0d, 0x41, 0x6c, 
+0x65, 0x72, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 
+0x65, 0x6e, 0x74, 0x19, 0x41, 0x6c, 0x65, 0x72, 
+0x74, 0x20, 0x31, 0x20, 0x66, 0x6f, 0x72, 0x20, 
+0x53, 0x61, 0x74, 0x6f, 0x73, 0x68, 0x69, 0x20, 
+0x30, 0x2e, 0x31, 0x2e, 0x30, 0x00, 0x46, 0x30, 
+0x44, 0x02, 0x20, 0x1a, 0xd9, 0xd3, 0xc6, 0x0f, 
+0x49, 0x26, 0xa9, 0x3e, 0xa6, 0x01, 0xf7, 0xea, 
+0xf0, 0xd5, 0xc1, 0x5b, 0xde, 0xf8, 0xff, 0xb6, 
+0x56, 0x12, 0x15, 0x41, 0xda, 0xfa, 0x44, 0xbe, 
+0x09, 0x4a, 0x8c, 0x02, 0x20, 0x0d, 0x1b, 0x5c, 
+0x3a, 0xd4, 0x6f, 0xba, 0xe8, 0x45, 0xae, 0x87, 
+0x5e, 0xf9, 0x56, 0xd5, 0xd0, 0x0c, 0x3d, 0x68, 
+0xfb, 0x1a, 0x48, 0x50, 0x3a, 0xfe, 0xda, 0x70, 
+0xe8, 0x38, 0x1a, 0xab, 0xb7, 0x7a, 0x01, 0x00, 
+0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x80, 0x51, 0x01, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x59, 
+0x3e, 0x0f, 0x00, 0x02, 0x0f, 0x2f, 0x53, 0x61, 
+0x74, 0x6f, 0x73, 0x68, 0x69, 0x3a, 0x30, 0x2e, 
+0x31, 0x2e, 0x30, 0x2f, 0x0f, 0x2f, 0x53, 0x61, 
+0x74, 0x6f, 0x73, 0x68, 0x69, 0x3a, 0x30, 0x2e, 
+0x32, 0x2e, 0x30, 0x2f, 0x01, 0x00, 0x00, 0x00, 
+0x0d, 0x41, 0x6c, 0x65, 0x72, 0x74, 0x20, 0x63, 
+0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x41, 
+0x6c, 0x65, 0x72, 0x74, 0x20, 0x31, 0x20, 0x66, 
+0x6f, 0x72, 0x20, 0x53, 0x61, 0x74, 0x6f, 0x73, 
+0x68, 0x69, 0x20, 0x30, 0x2e, 0x31, 0x2e, 0x30, 
+0x2c, 0x20, 0x30, 0x2e, 0x32, 0x2e, 0x30, 0x00, 
+0x46, 0x30, 0x44, 0x02, 0x20, 0x2f, 0x1a, 0x24, 
+0x8b, 0x55, 0x14, 0xa1, 0x0e, 0x7f, 0x91, 0x28, 
+0xd5, 0x88, 0xf9, 0x51, 0x4d, 0x3a, 0xd6, 0x57, 
+0x58, 0xd6, 0xd4, 0xe7, 0xf8, 0x42, 0x5f, 0x22, 
+0x2e, 0xca, 0xae, 0xbe, 0x36, 0x02, 0x20, 0x31, 
+0x8f, 0x14, 0x82, 0xf9, 0x87, 0x74, 0xd1, 0x8d, 
+0xda, 0xfc, 0x8d, 0x1c, 0x96, 0xe2, 0x29, 0xa8, 
+0xa2, 0x1a, 0x61, 0xbf, 0xa3, 0x2a, 0x7d, 0xd1, 
+0xe7, 0x25, 0xd7, 0x45, 0xa0, 0x4e, 0x36, 0x4c, 
+0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x80, 0x51, 0x01, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 
+0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x59, 0x3e, 0x0f, 0x00, 0x00, 0x64, 0x00, 
+0x00, 0x00, 0x0d, 0x41, 0x6c, 0x65, 0x72, 0x74, 
+0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74, 
+0x12, 0x41, 0x6c, 0x65, 0x72, 0x74, 0x20, 0x32, 
+0x2c, 0x20, 0x63, 0x61, 0x6e, 0x63, 0x65, 0x6c, 
+0x73, 0x20, 0x31, 0x00, 0x46, 0x30, 0x44, 0x02, 
+0x20, 0x2e, 0xd7, 0xb2, 0x9b, 0x1f, 0xa4, 0x15, 
+0x09, 0x45, 0xf0, 0x76, 0xa9, 0x3f, 0x7b, 0x2a, 
+0x05, 0x91, 0x7e, 0x3b, 0xed, 0x7e, 0x04, 0xbf, 
+0xbd, 0xe3, 0xd7, 0x31, 0x55, 0xd3, 0xb2, 0xae, 
+0xa4, 0x02, 0x20, 0x37, 0x43, 0xbc, 0x37, 0x3f, 
+0x27, 0x43, 0x5a, 0x60, 0xa6, 0x6d, 0xf3, 0x9e, 
+0xca, 0xf6, 0x60, 0xb9, 0x90, 0x66, 0xbd, 0xcd, 
+0x03, 0x50, 0x98, 0x34, 0xac, 0xc8, 0x56, 0x65, 
+0x10, 0x59, 0x27, 0x4c, 0x01, 0x00, 0x00, 0x00, 
+0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0xbc, 0x51, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x03, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x59, 0x3e, 0x0f, 
+0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x0d, 0x41, 
+0x6c, 0x65, 0x72, 0x74, 0x20, 0x63, 0x6f, 0x6d, 
+0x6d, 0x65, 0x6e, 0x74, 0x12, 0x41, 0x6c, 0x65, 
+0x72, 0x74, 0x20, 0x32, 0x2c, 0x20, 0x63, 0x61, 
+0x6e, 0x63, 0x65, 0x6c, 0x73, 0x20, 0x31, 0x00, 
+0x47, 0x30, 0x45, 0x02, 0x21, 0x00, 0x87, 0x95, 
+0xfd, 0xf6, 0x53, 0x30, 0xdd, 0xb9, 0xe8, 0x87, 
+0xf8, 0x76, 0xc0, 0x60, 0x67, 0xd9, 0x62, 0xfb, 
+0x7a, 0xf5, 0xd5, 0x91, 0x2c, 0xcc, 0xf8, 0xea, 
+0x98, 0xb4, 0x18, 0x5d, 0xd3, 0x20, 0x02, 0x20, 
+0x46, 0x0f, 0xab, 0xc9, 0xc1, 0x4a, 0xc6, 0xab, 
+0x2c, 0xf0, 0x0b, 0x59, 0x51, 0x23, 0xba, 0x32, 
+0x9f, 0xbf, 0xd9, 0x9e, 0x7f, 0xaf, 0x2a, 0x39, 
+0xbb, 0x39, 0x04, 0xc2, 0xd6, 0x29, 0xd3, 0xdd, 
+0x4c, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0xbc, 0x51, 0x01, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 
+0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x00, 
+0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 0x00, 0x64, 
+0x00, 0x00, 0x00, 0x0d, 0x41, 0x6c, 0x65, 0x72, 
+0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 
+0x74, 0x12, 0x41, 0x6c, 0x65, 0x72, 0x74, 0x20, 
+0x32, 0x2c, 0x20, 0x63, 0x61, 0x6e, 0x63, 0x65, 
+0x6c, 0x73, 0x20, 0x31, 0x00, 0x47, 0x30, 0x45, 
+0x02, 0x21, 0x00, 0xb9, 0x37, 0xbf, 0x5d, 0xe2, 
+0x65, 0x35, 0x95, 0x2f, 0x8f, 0x47, 0x8c, 0x61, 
+0x73, 0xd5, 0x1b, 0x36, 0xff, 0x22, 0x47, 0x12, 
+0xb3, 0x35, 0xd1, 0x85, 0x6e, 0x9e, 0x99, 0x78, 
+0xb0, 0xed, 0xe6, 0x02, 0x20, 0x54, 0x13, 0x26, 
+0xf9, 0x4e, 0x9e, 0x01, 0x4d, 0x91, 0x5b, 0xdc, 
+0x2a, 0x63, 0x9b, 0x64, 0x10, 0x2b, 0xe3, 0xf5, 
+0x34, 0x28, 0xca, 0x7b, 0x13, 0xf3, 0xdd, 0x23, 
+0x7e, 0x4a, 0x37, 0x23, 0x64, 0x63, 0x01, 0x00, 
+0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0xbc, 0x51, 0x01, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x01, 0x00, 
+0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x16, 
+0x00, 0x00, 0x00, 0x01, 0x0f, 0x2f, 0x53, 0x61, 
+0x74, 0x6f, 0x73, 0x68, 0x69, 0x3a, 0x30, 0x2e, 
+0x31, 0x2e, 0x30, 0x2f, 0x64, 0x00, 0x00, 0x00, 
+0x0d, 0x41, 0x6c, 0x65, 0x72, 0x74, 0x20, 0x63, 
+0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74, 0x19, 0x41, 
+0x6c, 0x65, 0x72, 0x74, 0x20, 0x32, 0x20, 0x66, 
+0x6f, 0x72, 0x20, 0x53, 0x61, 0x74, 0x6f, 0x73, 
+0x68, 0x69, 0x20, 0x30, 0x2e, 0x31, 0x2e, 0x30, 
+0x00, 0x47, 0x30, 0x45, 0x02, 0x21, 0x00, 0xd4, 
+0x91, 0x32, 0x51, 0xad, 0x3f, 0xb1, 0x53, 0x18, 
+0xa4, 0x74, 0xf7, 0x6d, 0x2b, 0x4c, 0xda, 0x75, 
+0x8a, 0x06, 0x5c, 0x81, 0xdf, 0x3b, 0x49, 0xe7, 
+0xf8, 0x8e, 0x7e, 0xa9, 0x81, 0xaa, 0x45, 0x02, 
+0x20, 0x61, 0xbe, 0xc3, 0x19, 0x83, 0x03, 0x0a, 
+0x0b, 0xe0, 0x32, 0xc9, 0x2c, 0xd4, 0x0b, 0xb7, 
+0xbf, 0xaa, 0xe2, 0xe0, 0xc9, 0x17, 0xc2, 0x67, 
+0xdc, 0x8e, 0x6a, 0x81, 0x6b, 0x69, 0x9a, 0x79, 
+0x60, 0x56, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbc, 0x51, 
+0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 
+0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x3f, 0x42, 0x0f, 0x00, 0x00, 
+0x64, 0x00, 0x00, 0x00, 0x0d, 0x41, 0x6c, 0x65, 
+0x72, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x65, 
+0x6e, 0x74, 0x1c, 0x45, 0x76, 0x69, 0x6c, 0x20, 
+0x41, 0x6c, 0x65, 0x72, 0x74, 0x27, 0x3b, 0x20, 
+0x2f, 0x62, 0x69, 0x6e, 0x2f, 0x6c, 0x73, 0x3b, 
+0x20, 0x65, 0x63, 0x68, 0x6f, 0x20, 0x27, 0x00, 
+0x46, 0x30, 0x44, 0x02, 0x20, 0x57, 0xcd, 0x8f, 
+0x22, 0x6f, 0x7c, 0xbd, 0x45, 0x39, 0xe2, 0x89, 
+0x3f, 0xcb, 0xd9, 0xbf, 0x33, 0xd6, 0x80, 0x94, 
+0x47, 0x7e, 0x0f, 0xcd, 0x83, 0xb1, 0x62, 0xa6, 
+0xf6, 0x01, 0x4c, 0xf7, 0x7c, 0x02, 0x20, 0x5e, 
+0x6f, 0x13, 0x7d, 0x6d, 0x55, 0x7f, 0xcc, 0x1f, 
+0xe8, 0xe5, 0x52, 0x28, 0xba, 0xe7, 0xd9, 0x03, 
+0x25, 0x93, 0x4d, 0x7c, 0xd4, 0x75, 0xce, 0x50, 
+0x8f, 0x2b, 0x3a, 0xa8, 0x8f, 0x81, 0x2b,  
+};};
@@ -0,0 +1,68 @@
+namespace json_tests{
+static unsigned const char sig_canonical[] = {
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x33, 
+0x30, 0x30, 0x36, 0x30, 0x32, 0x30, 0x31, 0x30, 
+0x30, 0x30, 0x32, 0x30, 0x31, 0x30, 0x30, 0x30, 
+0x31, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x33, 0x30, 0x30, 0x38, 0x30, 0x32, 0x30, 
+0x32, 0x30, 0x30, 0x66, 0x66, 0x30, 0x32, 0x30, 
+0x32, 0x30, 0x30, 0x66, 0x66, 0x30, 0x31, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x33, 
+0x30, 0x34, 0x34, 0x30, 0x32, 0x32, 0x30, 0x33, 
+0x39, 0x33, 0x32, 0x63, 0x38, 0x39, 0x32, 0x65, 
+0x32, 0x65, 0x35, 0x35, 0x30, 0x66, 0x33, 0x61, 
+0x66, 0x38, 0x65, 0x65, 0x34, 0x63, 0x65, 0x39, 
+0x63, 0x32, 0x31, 0x35, 0x61, 0x38, 0x37, 0x66, 
+0x39, 0x62, 0x62, 0x38, 0x33, 0x31, 0x64, 0x63, 
+0x61, 0x63, 0x38, 0x37, 0x62, 0x32, 0x38, 0x33, 
+0x38, 0x65, 0x32, 0x63, 0x32, 0x65, 0x61, 0x61, 
+0x38, 0x39, 0x31, 0x64, 0x66, 0x30, 0x63, 0x30, 
+0x32, 0x32, 0x30, 0x33, 0x30, 0x62, 0x36, 0x31, 
+0x64, 0x64, 0x33, 0x36, 0x35, 0x34, 0x33, 0x31, 
+0x32, 0x35, 0x64, 0x35, 0x36, 0x62, 0x39, 0x66, 
+0x39, 0x66, 0x33, 0x61, 0x31, 0x66, 0x39, 0x33, 
+0x35, 0x33, 0x31, 0x38, 0x39, 0x65, 0x35, 0x61, 
+0x66, 0x33, 0x33, 0x63, 0x64, 0x64, 0x61, 0x38, 
+0x64, 0x37, 0x37, 0x61, 0x35, 0x32, 0x30, 0x39, 
+0x61, 0x65, 0x63, 0x30, 0x33, 0x39, 0x37, 0x38, 
+0x66, 0x61, 0x30, 0x30, 0x31, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x33, 0x30, 0x34, 
+0x35, 0x30, 0x32, 0x32, 0x30, 0x30, 0x37, 0x36, 
+0x30, 0x34, 0x35, 0x62, 0x65, 0x36, 0x66, 0x39, 
+0x65, 0x63, 0x61, 0x32, 0x38, 0x66, 0x66, 0x31, 
+0x65, 0x63, 0x36, 0x30, 0x36, 0x62, 0x38, 0x33, 
+0x33, 0x64, 0x30, 0x62, 0x38, 0x37, 0x65, 0x37, 
+0x30, 0x62, 0x32, 0x61, 0x36, 0x33, 0x30, 0x66, 
+0x35, 0x65, 0x33, 0x61, 0x34, 0x39, 0x36, 0x62, 
+0x31, 0x31, 0x30, 0x39, 0x36, 0x37, 0x61, 0x34, 
+0x30, 0x66, 0x39, 0x30, 0x61, 0x30, 0x32, 0x32, 
+0x31, 0x30, 0x30, 0x38, 0x66, 0x66, 0x66, 0x64, 
+0x35, 0x39, 0x39, 0x39, 0x31, 0x30, 0x65, 0x65, 
+0x66, 0x65, 0x30, 0x30, 0x62, 0x63, 0x38, 0x30, 
+0x33, 0x63, 0x36, 0x38, 0x38, 0x63, 0x32, 0x65, 
+0x63, 0x61, 0x31, 0x64, 0x32, 0x62, 0x61, 0x37, 
+0x66, 0x36, 0x62, 0x31, 0x38, 0x30, 0x36, 0x32, 
+0x30, 0x65, 0x61, 0x61, 0x30, 0x33, 0x34, 0x38, 
+0x38, 0x65, 0x36, 0x35, 0x38, 0x35, 0x64, 0x62, 
+0x36, 0x62, 0x61, 0x30, 0x31, 0x22, 0x2c, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x33, 0x30, 0x34, 
+0x36, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x38, 
+0x37, 0x36, 0x30, 0x34, 0x35, 0x62, 0x65, 0x36, 
+0x66, 0x39, 0x65, 0x63, 0x61, 0x32, 0x38, 0x66, 
+0x66, 0x31, 0x65, 0x63, 0x36, 0x30, 0x36, 0x62, 
+0x38, 0x33, 0x33, 0x64, 0x30, 0x62, 0x38, 0x37, 
+0x65, 0x37, 0x30, 0x62, 0x32, 0x61, 0x36, 0x33, 
+0x30, 0x66, 0x35, 0x65, 0x33, 0x61, 0x34, 0x39, 
+0x36, 0x62, 0x31, 0x31, 0x30, 0x39, 0x36, 0x37, 
+0x61, 0x34, 0x30, 0x66, 0x39, 0x30, 0x61, 0x30, 
+0x32, 0x32, 0x31, 0x30, 0x30, 0x38, 0x66, 0x66, 
+0x66, 0x64, 0x35, 0x39, 0x39, 0x39, 0x31, 0x30, 
+0x65, 0x65, 0x66, 0x65, 0x30, 0x30, 0x62, 0x63, 
+0x38, 0x30, 0x33, 0x63, 0x36, 0x38, 0x38, 0x63, 
+0x32, 0x65, 0x63, 0x61, 0x31, 0x64, 0x32, 0x62, 
+0x61, 0x37, 0x66, 0x36, 0x62, 0x31, 0x38, 0x30, 
+0x36, 0x32, 0x30, 0x65, 0x61, 0x61, 0x30, 0x33, 
+0x34, 0x38, 0x38, 0x65, 0x36, 0x35, 0x38, 0x35, 
+0x64, 0x62, 0x36, 0x62, 0x61, 0x30, 0x31, 0x22, 
+0x0a, 0x5d, 0x0a,      
+};};
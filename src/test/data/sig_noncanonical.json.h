@@ -0,0 +1,282 @@
+namespace json_tests{
+static unsigned const char sig_noncanonical[] = {
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x6e, 
+0x6f, 0x6e, 0x2d, 0x68, 0x65, 0x78, 0x20, 0x73, 
+0x74, 0x72, 0x69, 0x6e, 0x67, 0x73, 0x20, 0x61, 
+0x72, 0x65, 0x20, 0x69, 0x67, 0x6e, 0x6f, 0x72, 
+0x65, 0x64, 0x22, 0x2c, 0x0a, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x74, 0x6f, 0x6f, 0x20, 0x73, 
+0x68, 0x6f, 0x72, 0x74, 0x3a, 0x22, 0x2c, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x33, 0x30, 0x30, 0x35, 
+0x30, 0x32, 0x30, 0x31, 0x46, 0x46, 0x30, 0x32, 
+0x30, 0x30, 0x30, 0x31, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x74, 0x6f, 0x6f, 0x20, 
+0x6c, 0x6f, 0x6e, 0x67, 0x3a, 0x22, 0x2c, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x33, 0x30, 0x34, 
+0x37, 0x30, 0x32, 0x32, 0x31, 0x30, 0x30, 0x35, 
+0x39, 0x39, 0x30, 0x65, 0x30, 0x35, 0x38, 0x34, 
+0x62, 0x32, 0x62, 0x32, 0x33, 0x38, 0x65, 0x31, 
+0x64, 0x66, 0x61, 0x61, 0x64, 0x38, 0x64, 0x36, 
+0x65, 0x64, 0x36, 0x39, 0x65, 0x63, 0x63, 0x31, 
+0x61, 0x34, 0x61, 0x31, 0x33, 0x61, 0x63, 0x38, 
+0x35, 0x66, 0x63, 0x30, 0x62, 0x33, 0x31, 0x64, 
+0x30, 0x64, 0x66, 0x33, 0x39, 0x35, 0x65, 0x62, 
+0x31, 0x62, 0x61, 0x36, 0x31, 0x30, 0x35, 0x30, 
+0x32, 0x32, 0x32, 0x30, 0x30, 0x30, 0x30, 0x32, 
+0x64, 0x35, 0x38, 0x37, 0x36, 0x32, 0x36, 0x32, 
+0x63, 0x32, 0x38, 0x38, 0x62, 0x65, 0x62, 0x35, 
+0x31, 0x31, 0x64, 0x30, 0x36, 0x31, 0x36, 0x39, 
+0x31, 0x62, 0x66, 0x32, 0x36, 0x37, 0x37, 0x37, 
+0x33, 0x34, 0x34, 0x62, 0x37, 0x30, 0x32, 0x62, 
+0x30, 0x30, 0x66, 0x38, 0x66, 0x65, 0x32, 0x38, 
+0x36, 0x32, 0x31, 0x66, 0x65, 0x34, 0x65, 0x35, 
+0x36, 0x36, 0x36, 0x39, 0x35, 0x65, 0x64, 0x30, 
+0x31, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x68, 0x61, 0x73, 0x68, 0x74, 0x79, 0x70, 
+0x65, 0x3a, 0x22, 0x2c, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x33, 0x30, 0x34, 0x34, 0x30, 0x32, 
+0x32, 0x30, 0x35, 0x39, 0x39, 0x30, 0x65, 0x30, 
+0x35, 0x38, 0x34, 0x62, 0x32, 0x62, 0x32, 0x33, 
+0x38, 0x65, 0x31, 0x64, 0x66, 0x61, 0x61, 0x64, 
+0x38, 0x64, 0x36, 0x65, 0x64, 0x36, 0x39, 0x65, 
+0x63, 0x63, 0x31, 0x61, 0x34, 0x61, 0x31, 0x33, 
+0x61, 0x63, 0x38, 0x35, 0x66, 0x63, 0x30, 0x62, 
+0x33, 0x31, 0x64, 0x30, 0x64, 0x66, 0x33, 0x39, 
+0x35, 0x65, 0x62, 0x31, 0x62, 0x61, 0x36, 0x31, 
+0x30, 0x35, 0x30, 0x32, 0x32, 0x30, 0x32, 0x64, 
+0x35, 0x38, 0x37, 0x36, 0x32, 0x36, 0x32, 0x63, 
+0x32, 0x38, 0x38, 0x62, 0x65, 0x62, 0x35, 0x31, 
+0x31, 0x64, 0x30, 0x36, 0x31, 0x36, 0x39, 0x31, 
+0x62, 0x66, 0x32, 0x36, 0x37, 0x37, 0x37, 0x33, 
+0x34, 0x34, 0x62, 0x37, 0x30, 0x32, 0x62, 0x30, 
+0x30, 0x66, 0x38, 0x66, 0x65, 0x32, 0x38, 0x36, 
+0x32, 0x31, 0x66, 0x65, 0x34, 0x65, 0x35, 0x36, 
+0x36, 0x36, 0x39, 0x35, 0x65, 0x64, 0x31, 0x31, 
+0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x74, 0x79, 0x70, 0x65, 0x3a, 0x22, 0x2c, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x33, 0x31, 0x34, 0x34, 0x30, 0x32, 0x32, 
+0x30, 0x35, 0x39, 0x39, 0x30, 0x65, 0x30, 0x35, 
+0x38, 0x34, 0x62, 0x32, 0x62, 0x32, 0x33, 0x38, 
+0x65, 0x31, 0x64, 0x66, 0x61, 0x61, 0x64, 0x38, 
+0x64, 0x36, 0x65, 0x64, 0x36, 0x39, 0x65, 0x63, 
+0x63, 0x31, 0x61, 0x34, 0x61, 0x31, 0x33, 0x61, 
+0x63, 0x38, 0x35, 0x66, 0x63, 0x30, 0x62, 0x33, 
+0x31, 0x64, 0x30, 0x64, 0x66, 0x33, 0x39, 0x35, 
+0x65, 0x62, 0x31, 0x62, 0x61, 0x36, 0x31, 0x30, 
+0x35, 0x30, 0x32, 0x32, 0x30, 0x32, 0x64, 0x35, 
+0x38, 0x37, 0x36, 0x32, 0x36, 0x32, 0x63, 0x32, 
+0x38, 0x38, 0x62, 0x65, 0x62, 0x35, 0x31, 0x31, 
+0x64, 0x30, 0x36, 0x31, 0x36, 0x39, 0x31, 0x62, 
+0x66, 0x32, 0x36, 0x37, 0x37, 0x37, 0x33, 0x34, 
+0x34, 0x62, 0x37, 0x30, 0x32, 0x62, 0x30, 0x30, 
+0x66, 0x38, 0x66, 0x65, 0x32, 0x38, 0x36, 0x32, 
+0x31, 0x66, 0x65, 0x34, 0x65, 0x35, 0x36, 0x36, 
+0x36, 0x39, 0x35, 0x65, 0x64, 0x30, 0x31, 0x22, 
+0x2c, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x74, 
+0x6f, 0x74, 0x61, 0x6c, 0x20, 0x6c, 0x65, 0x6e, 
+0x67, 0x74, 0x68, 0x3a, 0x22, 0x2c, 0x20, 0x22, 
+0x33, 0x30, 0x34, 0x35, 0x30, 0x32, 0x32, 0x30, 
+0x35, 0x39, 0x39, 0x30, 0x65, 0x30, 0x35, 0x38, 
+0x34, 0x62, 0x32, 0x62, 0x32, 0x33, 0x38, 0x65, 
+0x31, 0x64, 0x66, 0x61, 0x61, 0x64, 0x38, 0x64, 
+0x36, 0x65, 0x64, 0x36, 0x39, 0x65, 0x63, 0x63, 
+0x31, 0x61, 0x34, 0x61, 0x31, 0x33, 0x61, 0x63, 
+0x38, 0x35, 0x66, 0x63, 0x30, 0x62, 0x33, 0x31, 
+0x64, 0x30, 0x64, 0x66, 0x33, 0x39, 0x35, 0x65, 
+0x62, 0x31, 0x62, 0x61, 0x36, 0x31, 0x30, 0x35, 
+0x30, 0x32, 0x32, 0x30, 0x32, 0x64, 0x35, 0x38, 
+0x37, 0x36, 0x32, 0x36, 0x32, 0x63, 0x32, 0x38, 
+0x38, 0x62, 0x65, 0x62, 0x35, 0x31, 0x31, 0x64, 
+0x30, 0x36, 0x31, 0x36, 0x39, 0x31, 0x62, 0x66, 
+0x32, 0x36, 0x37, 0x37, 0x37, 0x33, 0x34, 0x34, 
+0x62, 0x37, 0x30, 0x32, 0x62, 0x30, 0x30, 0x66, 
+0x38, 0x66, 0x65, 0x32, 0x38, 0x36, 0x32, 0x31, 
+0x66, 0x65, 0x34, 0x65, 0x35, 0x36, 0x36, 0x36, 
+0x39, 0x35, 0x65, 0x64, 0x30, 0x31, 0x22, 0x2c, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x22, 0x53, 0x20, 
+0x6c, 0x65, 0x6e, 0x20, 0x6f, 0x6f, 0x62, 0x3a, 
+0x22, 0x2c, 0x20, 0x20, 0x20, 0x20, 0x22, 0x33, 
+0x30, 0x31, 0x46, 0x30, 0x31, 0x32, 0x30, 0x35, 
+0x39, 0x39, 0x30, 0x65, 0x30, 0x35, 0x38, 0x34, 
+0x62, 0x32, 0x62, 0x32, 0x33, 0x38, 0x65, 0x31, 
+0x64, 0x66, 0x61, 0x61, 0x64, 0x38, 0x64, 0x36, 
+0x65, 0x64, 0x36, 0x39, 0x65, 0x63, 0x63, 0x31, 
+0x61, 0x34, 0x61, 0x31, 0x33, 0x61, 0x63, 0x38, 
+0x35, 0x66, 0x63, 0x30, 0x62, 0x33, 0x31, 0x64, 
+0x30, 0x64, 0x66, 0x33, 0x39, 0x35, 0x65, 0x62, 
+0x31, 0x30, 0x31, 0x22, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x52, 0x2b, 0x53, 0x3a, 0x22, 
+0x2c, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x33, 0x30, 0x34, 0x35, 
+0x30, 0x32, 0x32, 0x30, 0x35, 0x39, 0x39, 0x30, 
+0x65, 0x30, 0x35, 0x38, 0x34, 0x62, 0x32, 0x62, 
+0x32, 0x33, 0x38, 0x65, 0x31, 0x64, 0x66, 0x61, 
+0x61, 0x64, 0x38, 0x64, 0x36, 0x65, 0x64, 0x36, 
+0x39, 0x65, 0x63, 0x63, 0x31, 0x61, 0x34, 0x61, 
+0x31, 0x33, 0x61, 0x63, 0x38, 0x35, 0x66, 0x63, 
+0x30, 0x62, 0x33, 0x31, 0x64, 0x30, 0x64, 0x66, 
+0x33, 0x39, 0x35, 0x65, 0x62, 0x31, 0x62, 0x61, 
+0x36, 0x31, 0x30, 0x35, 0x30, 0x32, 0x32, 0x30, 
+0x32, 0x64, 0x35, 0x38, 0x37, 0x36, 0x32, 0x36, 
+0x32, 0x63, 0x32, 0x38, 0x38, 0x62, 0x65, 0x62, 
+0x35, 0x31, 0x31, 0x64, 0x30, 0x36, 0x31, 0x36, 
+0x39, 0x31, 0x62, 0x66, 0x32, 0x36, 0x37, 0x37, 
+0x37, 0x33, 0x34, 0x34, 0x62, 0x37, 0x30, 0x32, 
+0x62, 0x30, 0x30, 0x66, 0x38, 0x66, 0x65, 0x32, 
+0x38, 0x36, 0x32, 0x31, 0x66, 0x65, 0x34, 0x65, 
+0x35, 0x36, 0x36, 0x36, 0x39, 0x35, 0x65, 0x64, 
+0x30, 0x30, 0x30, 0x31, 0x22, 0x2c, 0x0a, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x52, 0x20, 0x74, 
+0x79, 0x70, 0x65, 0x3a, 0x22, 0x2c, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x33, 0x30, 
+0x34, 0x34, 0x30, 0x31, 0x32, 0x30, 0x35, 0x39, 
+0x39, 0x30, 0x65, 0x30, 0x35, 0x38, 0x34, 0x62, 
+0x32, 0x62, 0x32, 0x33, 0x38, 0x65, 0x31, 0x64, 
+0x66, 0x61, 0x61, 0x64, 0x38, 0x64, 0x36, 0x65, 
+0x64, 0x36, 0x39, 0x65, 0x63, 0x63, 0x31, 0x61, 
+0x34, 0x61, 0x31, 0x33, 0x61, 0x63, 0x38, 0x35, 
+0x66, 0x63, 0x30, 0x62, 0x33, 0x31, 0x64, 0x30, 
+0x64, 0x66, 0x33, 0x39, 0x35, 0x65, 0x62, 0x31, 
+0x62, 0x61, 0x36, 0x31, 0x30, 0x35, 0x30, 0x32, 
+0x32, 0x30, 0x32, 0x64, 0x35, 0x38, 0x37, 0x36, 
+0x32, 0x36, 0x32, 0x63, 0x32, 0x38, 0x38, 0x62, 
+0x65, 0x62, 0x35, 0x31, 0x31, 0x64, 0x30, 0x36, 
+0x31, 0x36, 0x39, 0x31, 0x62, 0x66, 0x32, 0x36, 
+0x37, 0x37, 0x37, 0x33, 0x34, 0x34, 0x62, 0x37, 
+0x30, 0x32, 0x62, 0x30, 0x30, 0x66, 0x38, 0x66, 
+0x65, 0x32, 0x38, 0x36, 0x32, 0x31, 0x66, 0x65, 
+0x34, 0x65, 0x35, 0x36, 0x36, 0x36, 0x39, 0x35, 
+0x65, 0x64, 0x30, 0x31, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x52, 0x20, 0x6c, 0x65, 
+0x6e, 0x20, 0x3d, 0x20, 0x30, 0x3a, 0x22, 0x2c, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x33, 0x30, 0x32, 
+0x34, 0x30, 0x32, 0x30, 0x30, 0x30, 0x32, 0x32, 
+0x30, 0x32, 0x64, 0x35, 0x38, 0x37, 0x36, 0x32, 
+0x36, 0x32, 0x63, 0x32, 0x38, 0x38, 0x62, 0x65, 
+0x62, 0x35, 0x31, 0x31, 0x64, 0x30, 0x36, 0x31, 
+0x36, 0x39, 0x31, 0x62, 0x66, 0x32, 0x36, 0x37, 
+0x37, 0x37, 0x33, 0x34, 0x34, 0x62, 0x37, 0x30, 
+0x32, 0x62, 0x30, 0x30, 0x66, 0x38, 0x66, 0x65, 
+0x32, 0x38, 0x36, 0x32, 0x31, 0x66, 0x65, 0x34, 
+0x65, 0x35, 0x36, 0x36, 0x36, 0x39, 0x35, 0x65, 
+0x64, 0x30, 0x31, 0x22, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x52, 0x3c, 0x30, 0x3a, 0x22, 
+0x2c, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x33, 0x30, 0x34, 0x34, 
+0x30, 0x32, 0x32, 0x30, 0x38, 0x39, 0x39, 0x30, 
+0x65, 0x30, 0x35, 0x38, 0x34, 0x62, 0x32, 0x62, 
+0x32, 0x33, 0x38, 0x65, 0x31, 0x64, 0x66, 0x61, 
+0x61, 0x64, 0x38, 0x64, 0x36, 0x65, 0x64, 0x36, 
+0x39, 0x65, 0x63, 0x63, 0x31, 0x61, 0x34, 0x61, 
+0x31, 0x33, 0x61, 0x63, 0x38, 0x35, 0x66, 0x63, 
+0x30, 0x62, 0x33, 0x31, 0x64, 0x30, 0x64, 0x66, 
+0x33, 0x39, 0x35, 0x65, 0x62, 0x31, 0x62, 0x61, 
+0x36, 0x31, 0x30, 0x35, 0x30, 0x32, 0x32, 0x30, 
+0x32, 0x64, 0x35, 0x38, 0x37, 0x36, 0x32, 0x36, 
+0x32, 0x63, 0x32, 0x38, 0x38, 0x62, 0x65, 0x62, 
+0x35, 0x31, 0x31, 0x64, 0x30, 0x36, 0x31, 0x36, 
+0x39, 0x31, 0x62, 0x66, 0x32, 0x36, 0x37, 0x37, 
+0x37, 0x33, 0x34, 0x34, 0x62, 0x37, 0x30, 0x32, 
+0x62, 0x30, 0x30, 0x66, 0x38, 0x66, 0x65, 0x32, 
+0x38, 0x36, 0x32, 0x31, 0x66, 0x65, 0x34, 0x65, 
+0x35, 0x36, 0x36, 0x36, 0x39, 0x35, 0x65, 0x64, 
+0x30, 0x31, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x52, 0x20, 0x70, 0x61, 0x64, 0x64, 
+0x65, 0x64, 0x3a, 0x22, 0x2c, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x33, 0x30, 0x34, 0x35, 0x30, 
+0x32, 0x32, 0x31, 0x30, 0x30, 0x35, 0x39, 0x39, 
+0x30, 0x65, 0x30, 0x35, 0x38, 0x34, 0x62, 0x32, 
+0x62, 0x32, 0x33, 0x38, 0x65, 0x31, 0x64, 0x66, 
+0x61, 0x61, 0x64, 0x38, 0x64, 0x36, 0x65, 0x64, 
+0x36, 0x39, 0x65, 0x63, 0x63, 0x31, 0x61, 0x34, 
+0x61, 0x31, 0x33, 0x61, 0x63, 0x38, 0x35, 0x66, 
+0x63, 0x30, 0x62, 0x33, 0x31, 0x64, 0x30, 0x64, 
+0x66, 0x33, 0x39, 0x35, 0x65, 0x62, 0x31, 0x62, 
+0x61, 0x36, 0x31, 0x30, 0x35, 0x30, 0x32, 0x32, 
+0x30, 0x32, 0x64, 0x35, 0x38, 0x37, 0x36, 0x32, 
+0x36, 0x32, 0x63, 0x32, 0x38, 0x38, 0x62, 0x65, 
+0x62, 0x35, 0x31, 0x31, 0x64, 0x30, 0x36, 0x31, 
+0x36, 0x39, 0x31, 0x62, 0x66, 0x32, 0x36, 0x37, 
+0x37, 0x37, 0x33, 0x34, 0x34, 0x62, 0x37, 0x30, 
+0x32, 0x62, 0x30, 0x30, 0x66, 0x38, 0x66, 0x65, 
+0x32, 0x38, 0x36, 0x32, 0x31, 0x66, 0x65, 0x34, 
+0x65, 0x35, 0x36, 0x36, 0x36, 0x39, 0x35, 0x65, 
+0x64, 0x30, 0x31, 0x22, 0x2c, 0x0a, 0x0a, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x53, 0x20, 0x74, 
+0x79, 0x70, 0x65, 0x3a, 0x22, 0x2c, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x33, 0x30, 
+0x34, 0x34, 0x30, 0x32, 0x32, 0x30, 0x35, 0x39, 
+0x39, 0x30, 0x65, 0x30, 0x35, 0x38, 0x34, 0x62, 
+0x32, 0x62, 0x32, 0x33, 0x38, 0x65, 0x31, 0x64, 
+0x66, 0x61, 0x61, 0x64, 0x38, 0x64, 0x36, 0x65, 
+0x64, 0x36, 0x39, 0x65, 0x63, 0x63, 0x31, 0x61, 
+0x34, 0x61, 0x31, 0x33, 0x61, 0x63, 0x38, 0x35, 
+0x66, 0x63, 0x30, 0x62, 0x33, 0x31, 0x64, 0x30, 
+0x64, 0x66, 0x33, 0x39, 0x35, 0x65, 0x62, 0x31, 
+0x62, 0x61, 0x36, 0x31, 0x30, 0x35, 0x30, 0x31, 
+0x32, 0x30, 0x32, 0x64, 0x35, 0x38, 0x37, 0x36, 
+0x32, 0x36, 0x32, 0x63, 0x32, 0x38, 0x38, 0x62, 
+0x65, 0x62, 0x35, 0x31, 0x31, 0x64, 0x30, 0x36, 
+0x31, 0x36, 0x39, 0x31, 0x62, 0x66, 0x32, 0x36, 
+0x37, 0x37, 0x37, 0x33, 0x34, 0x34, 0x62, 0x37, 
+0x30, 0x32, 0x62, 0x30, 0x30, 0x66, 0x38, 0x66, 
+0x65, 0x32, 0x38, 0x36, 0x32, 0x31, 0x66, 0x65, 
+0x34, 0x65, 0x35, 0x36, 0x36, 0x36, 0x39, 0x35, 
+0x65, 0x64, 0x30, 0x31, 0x22, 0x2c, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x53, 0x20, 0x6c, 0x65, 
+0x6e, 0x20, 0x3d, 0x20, 0x30, 0x3a, 0x22, 0x2c, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x33, 0x30, 0x32, 
+0x34, 0x30, 0x32, 0x32, 0x30, 0x35, 0x39, 0x39, 
+0x30, 0x65, 0x30, 0x35, 0x38, 0x34, 0x62, 0x32, 
+0x62, 0x32, 0x33, 0x38, 0x65, 0x31, 0x64, 0x66, 
+0x61, 0x61, 0x64, 0x38, 0x64, 0x36, 0x65, 0x64, 
+0x36, 0x39, 0x65, 0x63, 0x63, 0x31, 0x61, 0x34, 
+0x61, 0x31, 0x33, 0x61, 0x63, 0x38, 0x35, 0x66, 
+0x63, 0x30, 0x62, 0x33, 0x31, 0x64, 0x30, 0x64, 
+0x66, 0x33, 0x39, 0x35, 0x65, 0x62, 0x31, 0x62, 
+0x61, 0x36, 0x31, 0x30, 0x35, 0x30, 0x32, 0x30, 
+0x30, 0x30, 0x31, 0x22, 0x2c, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x53, 0x3c, 0x30, 0x3a, 0x22, 
+0x2c, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x33, 0x30, 0x34, 0x34, 
+0x30, 0x32, 0x32, 0x30, 0x35, 0x39, 0x39, 0x30, 
+0x65, 0x30, 0x35, 0x38, 0x34, 0x62, 0x32, 0x62, 
+0x32, 0x33, 0x38, 0x65, 0x31, 0x64, 0x66, 0x61, 
+0x61, 0x64, 0x38, 0x64, 0x36, 0x65, 0x64, 0x36, 
+0x39, 0x65, 0x63, 0x63, 0x31, 0x61, 0x34, 0x61, 
+0x31, 0x33, 0x61, 0x63, 0x38, 0x35, 0x66, 0x63, 
+0x30, 0x62, 0x33, 0x31, 0x64, 0x30, 0x64, 0x66, 
+0x33, 0x39, 0x35, 0x65, 0x62, 0x31, 0x62, 0x61, 
+0x36, 0x31, 0x30, 0x35, 0x30, 0x32, 0x32, 0x30, 
+0x66, 0x64, 0x35, 0x38, 0x37, 0x36, 0x32, 0x36, 
+0x32, 0x63, 0x32, 0x38, 0x38, 0x62, 0x65, 0x62, 
+0x35, 0x31, 0x31, 0x64, 0x30, 0x36, 0x31, 0x36, 
+0x39, 0x31, 0x62, 0x66, 0x32, 0x36, 0x37, 0x37, 
+0x37, 0x33, 0x34, 0x34, 0x62, 0x37, 0x30, 0x32, 
+0x62, 0x30, 0x30, 0x66, 0x38, 0x66, 0x65, 0x32, 
+0x38, 0x36, 0x32, 0x31, 0x66, 0x65, 0x34, 0x65, 
+0x35, 0x36, 0x36, 0x36, 0x39, 0x35, 0x65, 0x64, 
+0x30, 0x31, 0x22, 0x2c, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x53, 0x20, 0x70, 0x61, 0x64, 0x64, 
+0x65, 0x64, 0x3a, 0x22, 0x2c, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x33, 0x30, 0x34, 0x35, 0x30, 
+0x32, 0x32, 0x30, 0x35, 0x39, 0x39, 0x30, 0x65, 
+0x30, 0x35, 0x38, 0x34, 0x62, 0x32, 0x62, 0x32, 
+0x33, 0x38, 0x65, 0x31, 0x64, 0x66, 0x61, 0x61, 
+0x64, 0x38, 0x64, 0x36, 0x65, 0x64, 0x36, 0x39, 
+0x65, 0x63, 0x63, 0x31, 0x61, 0x34, 0x61, 0x31, 
+0x33, 0x61, 0x63, 0x38, 0x35, 0x66, 0x63, 0x30, 
+0x62, 0x33, 0x31, 0x64, 0x30, 0x64, 0x66, 0x33, 
+0x39, 0x35, 0x65, 0x62, 0x31, 0x62, 0x61, 0x36, 
+0x31, 0x30, 0x35, 0x30, 0x32, 0x32, 0x31, 0x30, 
+0x30, 0x32, 0x64, 0x35, 0x38, 0x37, 0x36, 0x32, 
+0x36, 0x32, 0x63, 0x32, 0x38, 0x38, 0x62, 0x65, 
+0x62, 0x35, 0x31, 0x31, 0x64, 0x30, 0x36, 0x31, 
+0x36, 0x39, 0x31, 0x62, 0x66, 0x32, 0x36, 0x37, 
+0x37, 0x37, 0x33, 0x34, 0x34, 0x62, 0x37, 0x30, 
+0x32, 0x62, 0x30, 0x30, 0x66, 0x38, 0x66, 0x65, 
+0x32, 0x38, 0x36, 0x32, 0x31, 0x66, 0x65, 0x34, 
+0x65, 0x35, 0x36, 0x36, 0x36, 0x39, 0x35, 0x65, 
+0x64, 0x30, 0x31, 0x22, 0x0a, 0x5d, 0x0a,  
+};};
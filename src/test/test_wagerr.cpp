@@ -10,6 +10,7 @@
 
 #include "betting/bet.h"
 #include "betting/bet_db.h"
+#include "betting/bet_v3.h"
 #include "main.h"
 #include "random.h"
 #include "txdb.h"
@@ -67,15 +68,30 @@ TestingSetup::TestingSetup()
         bettingsView->eventsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-events"), CBettingDB::dbWrapperCacheSize(), true);
         bettingsView->events = MakeUnique<CBettingDB>(*bettingsView->eventsStorage.get());
 
+        bettingsView->eventStartTimesStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-eventstarttimes"), CBettingDB::dbWrapperCacheSize(), true);
+        bettingsView->eventStartTimes = MakeUnique<CBettingDB>(*bettingsView->eventStartTimesStorage.get());
+
         bettingsView->resultsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-results"), CBettingDB::dbWrapperCacheSize(), true);
         bettingsView->results = MakeUnique<CBettingDB>(*bettingsView->resultsStorage.get());
 
         bettingsView->betsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-bets"), CBettingDB::dbWrapperCacheSize(), true);
         bettingsView->bets = MakeUnique<CBettingDB>(*bettingsView->betsStorage.get());
 
+        bettingsView->eventBetsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-eventbets"), CBettingDB::dbWrapperCacheSize(), true);
+        bettingsView->eventBets = MakeUnique<CBettingDB>(*bettingsView->eventBetsStorage.get());
+
+        bettingsView->playerBetsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-playerbets"), CBettingDB::dbWrapperCacheSize(), true);
+        bettingsView->playerBets = MakeUnique<CBettingDB>(*bettingsView->playerBetsStorage.get());
+
+        bettingsView->bettingTxsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-bettingtxs"), CBettingDB::dbWrapperCacheSize(), true);
+        bettingsView->bettingTxs = MakeUnique<CBettingDB>(*bettingsView->bettingTxsStorage.get());
+
         bettingsView->undosStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-undos"), CBettingDB::dbWrapperCacheSize(), true);
         bettingsView->undos = MakeUnique<CBettingDB>(*bettingsView->undosStorage.get());
 
+        bettingsView->undoHeightsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-undoheights"), CBettingDB::dbWrapperCacheSize(), true);
+        bettingsView->undoHeights = MakeUnique<CBettingDB>(*bettingsView->undoHeightsStorage.get());
+
         bettingsView->payoutsInfoStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-payoutsinfo"), CBettingDB::dbWrapperCacheSize(), true);
         bettingsView->payoutsInfo = MakeUnique<CBettingDB>(*bettingsView->payoutsInfoStorage.get());
 
@@ -91,6 +107,15 @@ TestingSetup::TestingSetup()
         bettingsView->chainGamesLottoResultsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-cglottoresults"), CBettingDB::dbWrapperCacheSize(), true);
         bettingsView->chainGamesLottoResults = MakeUnique<CBettingDB>(*bettingsView->chainGamesLottoResultsStorage.get());
 
+        bettingsView->blockResultsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-blockresults"), CBettingDB::dbWrapperCacheSize(), true);
+        bettingsView->blockResults = MakeUnique<CBettingDB>(*bettingsView->blockResultsStorage.get());
+
+        bettingsView->completedBetsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-completedbets"), CBettingDB::dbWrapperCacheSize(), true);
+        bettingsView->completedBets = MakeUnique<CBettingDB>(*bettingsView->completedBetsStorage.get());
+
+        bettingsView->parlayLegsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-parlaylegs"), CBettingDB::dbWrapperCacheSize(), true);
+        bettingsView->parlayLegs = MakeUnique<CBettingDB>(*bettingsView->parlayLegsStorage.get());
+
         bettingsView->failedBettingTxsStorage = MakeUnique<CStorageLevelDB>(CBettingDB::MakeDbPath("test-failedtxs"), CBettingDB::dbWrapperCacheSize(), true);
         bettingsView->failedBettingTxs = MakeUnique<CBettingDB>(*bettingsView->failedBettingTxsStorage.get());
 
@@ -105,6 +130,8 @@ TestingSetup::TestingSetup()
         nScriptCheckThreads = 3;
         for (int i=0; i < nScriptCheckThreads-1; i++)
             threadGroup.create_thread(&ThreadScriptCheck);
+        for (int i=0; i < nScriptCheckThreads-1; i++)
+            threadGroup.create_thread(&ThreadBetCheck);
         RegisterNodeSignals(GetNodeSignals());
 }
 
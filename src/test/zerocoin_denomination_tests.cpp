@@ -4,10 +4,13 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "amount.h"
+#include "chain.h"
 #include "chainparams.h"
+#include "clientversion.h"
 #include "coincontrol.h"
 #include "denomination_functions.h"
 #include "main.h"
+#include "streams.h"
 #include "txdb.h"
 #include "wallet/wallet.h"
 #include "wallet/walletdb.h"
@@ -69,6 +72,35 @@ BOOST_AUTO_TEST_CASE(denomination_to_value_test)
     BOOST_CHECK_MESSAGE(libzerocoin::ZerocoinDenominationToAmount(denomination) == Value, "Wrong Value - should be 0");
 }
 
+BOOST_AUTO_TEST_CASE(zerocoin_supply_serialization_test)
+{
+    std::cout << "Running zerocoin_supply_serialization_test...\n";
+
+    std::map<libzerocoin::CoinDenomination, int16_t> mapSupply;
+    CZerocoinSupply supply;
+    int16_t n = -3;
+    for (auto& denom : libzerocoin::zerocoinDenomList) {
+        mapSupply[denom] = n;
+        supply.at(denom) = n;
+        n += 1000;
+    }
+
+    // the index entries on disk were written from a std::map, the format must not change
+    CDataStream ssMap(SER_DISK, CLIENT_VERSION);
+    CDataStream ssSupply(SER_DISK, CLIENT_VERSION);
+    ssMap << mapSupply;
+    ssSupply << supply;
+    BOOST_CHECK(ssMap.str() == ssSupply.str());
+    BOOST_CHECK_EQUAL(ssSupply.size(), ::GetSerializeSize(supply, SER_DISK, CLIENT_VERSION));
+
+    CZerocoinSupply supplyRead;
+    ssMap >> supplyRead;
+    for (auto& denom : libzerocoin::zerocoinDenomList)
+        BOOST_CHECK_EQUAL(supplyRead.at(denom), mapSupply.at(denom));
+
+    BOOST_CHECK_THROW(supply.at(libzerocoin::ZQ_ERROR), std::out_of_range);
+}
+
 BOOST_AUTO_TEST_CASE(zerocoin_spend_test241)
 {
     const int nMaxNumberOfSpends = 4;
@@ -219,6 +219,9 @@ bool CBlockTreeDB::LoadBlockIndexGuts()
     ssKeySet << std::make_pair('b', uint256(0));
     pcursor->Seek(ssKeySet.str());
 
+    // The keys hold the hash WriteBlockIndex took from the same header
+    const bool fTrustKeys = GetBoolArg("-trustblockindex", DEFAULT_TRUST_BLOCK_INDEX);
+
     // Load mapBlockIndex
     uint256 nPreviousCheckpoint;
     while (pcursor->Valid()) {
@@ -234,8 +237,15 @@ bool CBlockTreeDB::LoadBlockIndexGuts()
                 CDiskBlockIndex diskindex;
                 ssValue >> diskindex;
 
+                // Rehashing is a Quark hash for the headers of the PoW era
+                uint256 hashBlock;
+                if (fTrustKeys)
+                    ssKey >> hashBlock;
+                else
+                    hashBlock = diskindex.GetBlockHash();
+
                 // Construct block index object
-                CBlockIndex* pindexNew = InsertBlockIndex(diskindex.GetBlockHash());
+                CBlockIndex* pindexNew = InsertBlockIndex(hashBlock);
                 pindexNew->pprev = InsertBlockIndex(diskindex.hashPrev);
                 pindexNew->pnext = InsertBlockIndex(diskindex.hashNext);
                 pindexNew->nHeight = diskindex.nHeight;
@@ -252,7 +262,7 @@ bool CBlockTreeDB::LoadBlockIndexGuts()
 
                 //zerocoin
                 pindexNew->nAccumulatorCheckpoint = diskindex.nAccumulatorCheckpoint;
-                pindexNew->mapZerocoinSupply = diskindex.mapZerocoinSupply;
+                pindexNew->zerocoinSupply = diskindex.zerocoinSupply;
                 pindexNew->vMintDenominationsInBlock = diskindex.vMintDenominationsInBlock;
 
                 //Proof Of Stake
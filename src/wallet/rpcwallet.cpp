@@ -85,43 +85,21 @@ UniValue listevents(const UniValue& params, bool fHelp)
     {
         LOCK(cs_bettingdb);
 
-        auto it = bettingsView->events->NewIterator();
-        for (it->Seek(std::vector<unsigned char>{}); it->Valid(); it->Next()) {
-            CPeerlessExtendedEventDB plEvent;
-            CMappingDB mapping;
-            CBettingDB::BytesToDbType(it->Value(), plEvent);
-
-            if (!bettingsView->mappings->Read(MappingKey{sportMapping, plEvent.nSport}, mapping))
+        // Only list active events.
+        for (const CUpcomingEvent& plEvent : bettingsView->GetUpcomingEvents(std::time(0))) {
+            if (!plEvent.fNamesResolved)
                 continue;
 
-            std::string sport = mapping.sName;
-
             // if event filter is set the don't list event if it doesn't match the filter.
-            if (params.size() > 0 && sportFilter != sport) {
-                continue;
-            }
-
-            // Only list active events.
-            if ((time_t) plEvent.nStartTime < std::time(0)) {
+            if (params.size() > 0 && sportFilter != plEvent.sSport) {
                 continue;
             }
 
-            //std::string round    = roundsIndex.find(plEvent.nStage)->second.sName;
-            if (!bettingsView->mappings->Read(MappingKey{tournamentMapping, plEvent.nTournament}, mapping))
-                continue;
-            std::string tournament = mapping.sName;
-            if (!bettingsView->mappings->Read(MappingKey{teamMapping, plEvent.nHomeTeam}, mapping))
-                continue;
-            std::string homeTeam = mapping.sName;
-            if (!bettingsView->mappings->Read(MappingKey{teamMapping, plEvent.nAwayTeam}, mapping))
-                continue;
-            std::string awayTeam = mapping.sName;
-
             UniValue evt(UniValue::VOBJ);
 
             evt.push_back(Pair("event_id", (uint64_t) plEvent.nEventId));
-            evt.push_back(Pair("sport", sport));
-            evt.push_back(Pair("tournament", tournament));
+            evt.push_back(Pair("sport", plEvent.sSport));
+            evt.push_back(Pair("tournament", plEvent.sTournament));
             //evt.push_back(Pair("round", ""));
 
             evt.push_back(Pair("starting", (uint64_t) plEvent.nStartTime));
@@ -129,8 +107,8 @@ UniValue listevents(const UniValue& params, bool fHelp)
 
             UniValue teams(UniValue::VOBJ);
 
-            teams.push_back(Pair("home", homeTeam));
-            teams.push_back(Pair("away", awayTeam));
+            teams.push_back(Pair("home", plEvent.sHomeTeam));
+            teams.push_back(Pair("away", plEvent.sAwayTeam));
 
             evt.push_back(Pair("teams", teams));
 
@@ -193,7 +171,7 @@ UniValue listeventsdebug(const UniValue& params, bool fHelp)
         for (it->Seek(std::vector<unsigned char>{}); it->Valid(); it->Next()) {
             CPeerlessExtendedEventDB plEvent;
             CMappingDB mapping;
-            CBettingDB::BytesToDbType(it->Value(), plEvent);
+            CBettingDB::BytesToDbType(it->ValueSlice(), plEvent);
 
             std::stringstream strStream;
 
@@ -205,16 +183,16 @@ UniValue listeventsdebug(const UniValue& params, bool fHelp)
                 << ", totalPoints: " << plEvent.nTotalPoints << ", totalOverOdds: " << plEvent.nTotalOverOdds << ", totalUnderOdds: " << plEvent.nTotalUnderOdds
                 << ", started: " << started << ".";
 
-            if (!bettingsView->mappings->Read(MappingKey{sportMapping, plEvent.nSport}, mapping)) {
+            if (!bettingsView->ReadMapping(MappingKey{sportMapping, plEvent.nSport}, mapping)) {
                 strStream << " No sport mapping!";
             }
-            if (!bettingsView->mappings->Read(MappingKey{tournamentMapping, plEvent.nTournament}, mapping)) {
+            if (!bettingsView->ReadMapping(MappingKey{tournamentMapping, plEvent.nTournament}, mapping)) {
                 strStream << " No tournament mapping!";
             }
-            if (!bettingsView->mappings->Read(MappingKey{teamMapping, plEvent.nHomeTeam}, mapping)) {
+            if (!bettingsView->ReadMapping(MappingKey{teamMapping, plEvent.nHomeTeam}, mapping)) {
                 strStream << " No home team mapping!";
             }
-            if (!bettingsView->mappings->Read(MappingKey{teamMapping, plEvent.nAwayTeam}, mapping)) {
+            if (!bettingsView->ReadMapping(MappingKey{teamMapping, plEvent.nAwayTeam}, mapping)) {
                 strStream << " No away team mapping!";
             }
 
@@ -369,13 +347,13 @@ UniValue listbets(const UniValue& params, bool fHelp)
 
                         entry.push_back(Pair("starting", plEvent.nStartTime));
                         CMappingDB mapping;
-                        if (bettingsView->mappings->Read(MappingKey{teamMapping, plEvent.nHomeTeam}, mapping)) {
+                        if (bettingsView->ReadMapping(MappingKey{teamMapping, plEvent.nHomeTeam}, mapping)) {
                             entry.push_back(Pair("home", mapping.sName));
                         }
-                        if (bettingsView->mappings->Read(MappingKey{teamMapping, plEvent.nAwayTeam}, mapping)) {
+                        if (bettingsView->ReadMapping(MappingKey{teamMapping, plEvent.nAwayTeam}, mapping)) {
                             entry.push_back(Pair("away", mapping.sName));
                         }
-                        if (bettingsView->mappings->Read(MappingKey{tournamentMapping, plEvent.nTournament}, mapping)) {
+                        if (bettingsView->ReadMapping(MappingKey{tournamentMapping, plEvent.nTournament}, mapping)) {
                             entry.push_back(Pair("tournament", mapping.sName));
                         }
                     }
@@ -529,13 +507,13 @@ UniValue getbet(const UniValue& params, bool fHelp)
 
                 ret.push_back(Pair("starting", plEvent.nStartTime));
                 CMappingDB mapping;
-                if (bettingsView->mappings->Read(MappingKey{teamMapping, plEvent.nHomeTeam}, mapping)) {
+                if (bettingsView->ReadMapping(MappingKey{teamMapping, plEvent.nHomeTeam}, mapping)) {
                     ret.push_back(Pair("home", mapping.sName));
                 }
-                if (bettingsView->mappings->Read(MappingKey{teamMapping, plEvent.nAwayTeam}, mapping)) {
+                if (bettingsView->ReadMapping(MappingKey{teamMapping, plEvent.nAwayTeam}, mapping)) {
                     ret.push_back(Pair("away", mapping.sName));
                 }
-                if (bettingsView->mappings->Read(MappingKey{tournamentMapping, plEvent.nTournament}, mapping)) {
+                if (bettingsView->ReadMapping(MappingKey{tournamentMapping, plEvent.nTournament}, mapping)) {
                     ret.push_back(Pair("tournament", mapping.sName));
                 }
             }
@@ -646,8 +624,8 @@ UniValue listbetsdb(const UniValue& params, bool fHelp)
         for(it->Seek(std::vector<unsigned char>{}); it->Valid(); it->Next()) {
             PeerlessBetKey key;
             CPeerlessBetDB uniBet;
-            CBettingDB::BytesToDbType(it->Value(), uniBet);
-            CBettingDB::BytesToDbType(it->Key(), key);
+            CBettingDB::BytesToDbType(it->ValueSlice(), uniBet);
+            CBettingDB::BytesToDbType(it->KeySlice(), key);
 
             if (!includeHandled && uniBet.IsCompleted()) continue;
 
@@ -741,19 +719,19 @@ void CollectPLBetData(UniValue& uValue, const PeerlessBetKey& betKey, const CPee
         if (bettingsView->events->Read(EventKey{leg.nEventId}, plEvent)) {
             uLockedEvent.push_back(Pair("starting", plEvent.nStartTime));
             CMappingDB mapping;
-            if (bettingsView->mappings->Read(MappingKey{teamMapping, plEvent.nHomeTeam}, mapping)) {
+            if (bettingsView->ReadMapping(MappingKey{teamMapping, plEvent.nHomeTeam}, mapping)) {
                 uLockedEvent.push_back(Pair("home", mapping.sName));
             }
             else {
                 uLockedEvent.push_back(Pair("home", "undefined"));
             }
-            if (bettingsView->mappings->Read(MappingKey{teamMapping, plEvent.nAwayTeam}, mapping)) {
+            if (bettingsView->ReadMapping(MappingKey{teamMapping, plEvent.nAwayTeam}, mapping)) {
                 uLockedEvent.push_back(Pair("away", mapping.sName));
             }
             else {
                 uLockedEvent.push_back(Pair("away", "undefined"));
             }
-            if (bettingsView->mappings->Read(MappingKey{tournamentMapping, plEvent.nTournament}, mapping)) {
+            if (bettingsView->ReadMapping(MappingKey{tournamentMapping, plEvent.nTournament}, mapping)) {
                 uLockedEvent.push_back(Pair("tournament", mapping.sName));
             }
             else {
@@ -819,8 +797,8 @@ void CollectPLBetData(UniValue& uValue, const PeerlessBetKey& betKey, const CPee
                 for (it->Seek(CBettingDB::DbTypeToBytes(PayoutInfoKey{uniBet.payoutHeight, COutPoint{}})); it->Valid(); it->Next()) {
                     PayoutInfoKey payoutKey;
                     CPayoutInfoDB payoutInfo;
-                    CBettingDB::BytesToDbType(it->Key(), payoutKey);
-                    CBettingDB::BytesToDbType(it->Value(), payoutInfo);
+                    CBettingDB::BytesToDbType(it->KeySlice(), payoutKey);
+                    CBettingDB::BytesToDbType(it->ValueSlice(), payoutInfo);
                     if (uniBet.payoutHeight != payoutKey.blockHeight) break;
                     if (payoutInfo.betKey == betKey) {
                         uValue.push_back(Pair("payoutTxHash", payoutKey.outPoint.hash.GetHex()));
@@ -841,6 +819,31 @@ void CollectPLBetData(UniValue& uValue, const PeerlessBetKey& betKey, const CPee
     }
 }
 
+/**
+ * Scripts the wallet may have placed bets from. Bets found by these scripts are still
+ * checked with IsMine, this only narrows down the player bets index lookups.
+ */
+std::set<CScript> GetWalletPlayerScripts(CWallet *_pwalletMain, bool includeWatchonly) {
+    std::set<CScript> playerScripts;
+
+    std::set<CKeyID> setKeyIds;
+    _pwalletMain->GetKeys(setKeyIds);
+    for (const CKeyID& keyId : setKeyIds) {
+        playerScripts.insert(GetScriptForDestination(keyId));
+    }
+    std::set<CScriptID> setScriptIds;
+    _pwalletMain->GetCScripts(setScriptIds);
+    for (const CScriptID& scriptId : setScriptIds) {
+        playerScripts.insert(GetScriptForDestination(scriptId));
+    }
+    if (includeWatchonly) {
+        WatchOnlySet setWatchOnly;
+        _pwalletMain->GetWatchOnly(setWatchOnly);
+        playerScripts.insert(setWatchOnly.begin(), setWatchOnly.end());
+    }
+    return playerScripts;
+}
+
 UniValue GetBets(uint32_t count, uint32_t from, CWallet *_pwalletMain, boost::optional<std::string> accountName, bool includeWatchonly) {
     UniValue ret(UniValue::VARR);
 
@@ -851,24 +854,19 @@ UniValue GetBets(uint32_t count, uint32_t from, CWallet *_pwalletMain, boost::op
 
     LOCK(cs_bettingdb);
 
-    auto it = bettingsView->bets->NewIterator();
     uint32_t skippedEntities = 0;
-    for(it->SeekToLast(); it->Valid(); it->Prev()) {
-        PeerlessBetKey key;
-        CPeerlessBetDB uniBet;
-        CBettingDB::BytesToDbType(it->Value(), uniBet);
-        CBettingDB::BytesToDbType(it->Key(), key);
-
+    // returns false when enough bets are collected
+    auto collectBet = [&](const PeerlessBetKey& key, const CPeerlessBetDB& uniBet) {
         if (_pwalletMain) {
             CTxDestination dest = uniBet.playerAddress.Get();
             isminetype scriptType = IsMine(*_pwalletMain, dest);
             if (scriptType == ISMINE_NO)
-                continue;
+                return true;
             if (scriptType == ISMINE_WATCH_ONLY && !includeWatchonly)
-                continue;
+                return true;
             if (!fAllAccounts && accountName && _pwalletMain->mapAddressBook.count(dest))
                 if (_pwalletMain->mapAddressBook[dest].name != *accountName)
-                    continue;
+                    return true;
         }
 
         UniValue uValue(UniValue::VOBJ);
@@ -881,8 +879,28 @@ UniValue GetBets(uint32_t count, uint32_t from, CWallet *_pwalletMain, boost::op
             skippedEntities++;
         }
 
-        if (count != 0 && ret.size() == count) {
-            break;
+        return count == 0 || ret.size() != count;
+    };
+
+    if (_pwalletMain) {
+        // walk only the bets of the wallet scripts, in the same newest first order
+        bettingsView->ForEachPlayerBet(GetWalletPlayerScripts(_pwalletMain, includeWatchonly), playerPeerlessBet, [&](const PeerlessBetKey& key) {
+            CPeerlessBetDB uniBet;
+            if (!bettingsView->bets->Read(key, uniBet))
+                return true;
+            return collectBet(key, uniBet);
+        });
+    }
+    else {
+        auto it = bettingsView->bets->NewIterator();
+        for(it->SeekToLast(); it->Valid(); it->Prev()) {
+            PeerlessBetKey key;
+            CPeerlessBetDB uniBet;
+            CBettingDB::BytesToDbType(it->ValueSlice(), uniBet);
+            CBettingDB::BytesToDbType(it->KeySlice(), key);
+
+            if (!collectBet(key, uniBet))
+                break;
         }
     }
     std::vector<UniValue> arrTmp = ret.getValues();
@@ -1076,8 +1094,8 @@ void CollectQGBetData(UniValue &uValue, QuickGamesBetKey &key, CQuickGamesBetDB
             for (it->Seek(CBettingDB::DbTypeToBytes(PayoutInfoKey{payoutHeight, COutPoint{}})); it->Valid(); it->Next()) {
                 PayoutInfoKey payoutKey;
                 CPayoutInfoDB payoutInfo;
-                CBettingDB::BytesToDbType(it->Key(), payoutKey);
-                CBettingDB::BytesToDbType(it->Value(), payoutInfo);
+                CBettingDB::BytesToDbType(it->KeySlice(), payoutKey);
+                CBettingDB::BytesToDbType(it->ValueSlice(), payoutInfo);
 
                 if (payoutHeight != payoutKey.blockHeight)
                     break;
@@ -1101,25 +1119,21 @@ UniValue GetQuickGamesBets(uint32_t count, uint32_t from, CWallet *_pwalletMain,
 
     LOCK(cs_bettingdb);
 
-    auto it = bettingsView->quickGamesBets->NewIterator();
     uint32_t skippedEntities = 0;
-    for(it->SeekToLast(); it->Valid(); it->Prev()) {
-        QuickGamesBetKey key;
-        CQuickGamesBetDB qgBet;
+    // returns false when enough bets are collected
+    auto collectBet = [&](QuickGamesBetKey& key, CQuickGamesBetDB& qgBet) {
         uint256 hash;
-        CBettingDB::BytesToDbType(it->Value(), qgBet);
-        CBettingDB::BytesToDbType(it->Key(), key);
 
         if (_pwalletMain) {
             CTxDestination dest = qgBet.playerAddress.Get();
             isminetype scriptType = IsMine(*_pwalletMain, dest);
             if (scriptType == ISMINE_NO)
-                continue;
+                return true;
             if (scriptType == ISMINE_WATCH_ONLY && !includeWatchonly)
-                continue;
+                return true;
             if (accountName && _pwalletMain->mapAddressBook.count(dest))
                 if (_pwalletMain->mapAddressBook[dest].name != *accountName)
-                    continue;
+                    return true;
 
         }
 
@@ -1139,8 +1153,29 @@ UniValue GetQuickGamesBets(uint32_t count, uint32_t from, CWallet *_pwalletMain,
             skippedEntities++;
         }
 
-        if (count != 0 && ret.size() == count) {
-            break;
+        return count == 0 || ret.size() != count;
+    };
+
+    if (_pwalletMain) {
+        // walk only the bets of the wallet scripts, in the same newest first order
+        bettingsView->ForEachPlayerBet(GetWalletPlayerScripts(_pwalletMain, includeWatchonly), playerQuickGamesBet, [&](const PeerlessBetKey& betKey) {
+            QuickGamesBetKey key{betKey};
+            CQuickGamesBetDB qgBet;
+            if (!bettingsView->quickGamesBets->Read(key, qgBet))
+                return true;
+            return collectBet(key, qgBet);
+        });
+    }
+    else {
+        auto it = bettingsView->quickGamesBets->NewIterator();
+        for(it->SeekToLast(); it->Valid(); it->Prev()) {
+            QuickGamesBetKey key;
+            CQuickGamesBetDB qgBet;
+            CBettingDB::BytesToDbType(it->ValueSlice(), qgBet);
+            CBettingDB::BytesToDbType(it->KeySlice(), key);
+
+            if (!collectBet(key, qgBet))
+                break;
         }
     }
 
@@ -1304,16 +1339,15 @@ UniValue getbetbytxid(const UniValue& params, bool fHelp)
     uint256 txHash;
     txHash.SetHex(params[0].get_str());
 
-    CTransaction tx;
-    uint256 hashBlock;
-    if (!GetTransaction(txHash, tx, hashBlock, true)) {
-        throw std::runtime_error("Invalid bet's transaction id");
-    }
-
-    CBlockIndex* blockindex = mapBlockIndex[hashBlock];
-
-    if (!blockindex) {
-        throw std::runtime_error("Invalid block index");
+    uint32_t betHeight;
+    if (!bettingsView->GetBettingTxHeight(txHash, betHeight)) {
+        // not a bet tx, keep reporting unknown transactions as errors
+        CTransaction tx;
+        uint256 hashBlock;
+        if (!GetTransaction(txHash, tx, hashBlock, true)) {
+            throw std::runtime_error("Invalid bet's transaction id");
+        }
+        return UniValue{UniValue::VARR};
     }
 
     UniValue ret{UniValue::VARR};
@@ -1322,11 +1356,11 @@ UniValue getbetbytxid(const UniValue& params, bool fHelp)
         LOCK(cs_bettingdb);
 
         auto it = bettingsView->bets->NewIterator();
-        for (it->Seek(CBettingDB::DbTypeToBytes(PeerlessBetKey{static_cast<uint32_t>(blockindex->nHeight), COutPoint{txHash, 0}})); it->Valid(); it->Next()) {
+        for (it->Seek(CBettingDB::DbTypeToBytes(PeerlessBetKey{betHeight, COutPoint{txHash, 0}})); it->Valid(); it->Next()) {
             PeerlessBetKey key;
             CPeerlessBetDB uniBet;
-            CBettingDB::BytesToDbType(it->Value(), uniBet);
-            CBettingDB::BytesToDbType(it->Key(), key);
+            CBettingDB::BytesToDbType(it->ValueSlice(), uniBet);
+            CBettingDB::BytesToDbType(it->KeySlice(), key);
 
             if (key.outPoint.hash != txHash) break;
 
@@ -1341,12 +1375,12 @@ UniValue getbetbytxid(const UniValue& params, bool fHelp)
         LOCK(cs_bettingdb);
 
         auto it = bettingsView->quickGamesBets->NewIterator();
-        for (it->Seek(CBettingDB::DbTypeToBytes(PeerlessBetKey{static_cast<uint32_t>(blockindex->nHeight), COutPoint{txHash, 0}})); it->Valid(); it->Next()) {
+        for (it->Seek(CBettingDB::DbTypeToBytes(PeerlessBetKey{betHeight, COutPoint{txHash, 0}})); it->Valid(); it->Next()) {
             QuickGamesBetKey key;
             CQuickGamesBetDB qgBet;
             uint256 hash;
-            CBettingDB::BytesToDbType(it->Key(), key);
-            CBettingDB::BytesToDbType(it->Value(), qgBet);
+            CBettingDB::BytesToDbType(it->KeySlice(), key);
+            CBettingDB::BytesToDbType(it->ValueSlice(), qgBet);
 
             if (key.outPoint.hash != txHash) break;
 
@@ -2054,7 +2088,7 @@ UniValue getchaingamesinfo(const UniValue& params, bool fHelp)
     if (resultHeight > Params().WagerrProtocolV2StartHeight() && fShowWinner) {
         std::vector<CBetOut> vExpectedCGLottoPayouts;
         std::vector<CPayoutInfoDB> vPayoutsInfo;
-        GetCGLottoBetPayoutsV2(resultHeight, vExpectedCGLottoPayouts, vPayoutsInfo);
+        GetCGLottoBetPayoutsV2(*bettingsView, resultHeight, vExpectedCGLottoPayouts, vPayoutsInfo);
         for (auto lottoPayouts : vExpectedCGLottoPayouts) {
             if (!winningBetFound && lottoPayouts.nEventId == eventID) {
                 winningBetOut = lottoPayouts;
@@ -2133,22 +2167,8 @@ UniValue getalleventliabilities(const UniValue& params, bool fHelp)
     {
         LOCK(cs_bettingdb);
 
-        auto it = bettingsView->events->NewIterator();
-        for (it->Seek(std::vector<unsigned char>{}); it->Valid(); it->Next()) {
-            CPeerlessExtendedEventDB plEvent;
-            CBettingDB::BytesToDbType(it->Value(), plEvent);
-
-            // Only list active events.
-            /*
-            if (plEvent.nEventCreationHeight < chainActive.Height() - Params().BetBlocksIndexTimespan()) {
-                continue;
-            }
-            */
-            // Only list active events.
-            if ((time_t) plEvent.nStartTime < std::time(0)) {
-                continue;
-            }
-
+        // Only list active events.
+        for (const CUpcomingEvent& plEvent : bettingsView->GetUpcomingEvents(std::time(0))) {
             UniValue event(UniValue::VOBJ);
 
             event.push_back(Pair("event-id", (uint64_t) plEvent.nEventId));